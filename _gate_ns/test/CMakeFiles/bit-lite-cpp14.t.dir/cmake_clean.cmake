@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bit-lite-cpp14.t.dir/bit-main.t.cpp.o"
+  "CMakeFiles/bit-lite-cpp14.t.dir/bit-main.t.cpp.o.d"
+  "CMakeFiles/bit-lite-cpp14.t.dir/bit.t.cpp.o"
+  "CMakeFiles/bit-lite-cpp14.t.dir/bit.t.cpp.o.d"
+  "bit-lite-cpp14.t"
+  "bit-lite-cpp14.t.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bit-lite-cpp14.t.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
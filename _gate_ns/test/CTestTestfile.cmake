@@ -0,0 +1,16 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_gate_ns/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(test-cpp98 "/root/repo/_gate_ns/test/bit-lite-cpp98.t")
+set_tests_properties(test-cpp98 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;229;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test-cpp11 "/root/repo/_gate_ns/test/bit-lite-cpp11.t")
+set_tests_properties(test-cpp11 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;232;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test-cpp14 "/root/repo/_gate_ns/test/bit-lite-cpp14.t")
+set_tests_properties(test-cpp14 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;235;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test-cpp17 "/root/repo/_gate_ns/test/bit-lite-cpp17.t")
+set_tests_properties(test-cpp17 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;238;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(test-cpp20 "/root/repo/_gate_ns/test/bit-lite-cpp20.t")
+set_tests_properties(test-cpp20 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;241;add_test;/root/repo/test/CMakeLists.txt;0;")
@@ -0,0 +1,1288 @@
+//
+// Copyright (c) 2020-2026 Martin Moene
+//
+// https://github.com/martinmoene/bit-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Microbenchmarks of the <bit> functions for nonstd, std (C++20) and compiler
+// builtins (GCC, Clang), with command line options and JSON output compatible
+// with Google Benchmark, e.g. for use with its tools/compare.py.
+
+// Measure the bit-lite implementation, also where C++20 <bit> is available:
+
+#ifndef  bit_CONFIG_SELECT_BIT
+# define bit_CONFIG_SELECT_BIT  bit_BIT_NONSTD
+#endif
+
+#include "nonstd/bit.hpp"
+
+#include <climits>      // CHAR_BIT
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if bit_CPP11_OR_GREATER
+# include <chrono>
+# include <cstdint>
+#endif
+
+// Standard C++20 <bit>:
+
+#if bit_CPP20_OR_GREATER && defined( __has_include )
+# if __has_include( <bit> )
+#  include <bit>
+#  include <version>
+# endif
+#endif
+
+#if defined( __cpp_lib_bitops )
+# define bench_HAVE_STD_BIT  1
+#else
+# define bench_HAVE_STD_BIT  0
+#endif
+
+#if defined( __cpp_lib_byteswap )
+# define bench_HAVE_STD_BYTESWAP  1
+#else
+# define bench_HAVE_STD_BYTESWAP  0
+#endif
+
+#if defined( __cpp_lib_bit_cast )
+# define bench_HAVE_STD_BIT_CAST  1
+#else
+# define bench_HAVE_STD_BIT_CAST  0
+#endif
+
+// Compiler builtins:
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+# define bench_HAVE_BUILTINS  1
+#else
+# define bench_HAVE_BUILTINS  0
+#endif
+
+#if defined( _MSC_VER )
+# include <intrin.h>    // _ReadWriteBarrier()
+#endif
+
+#if bit_CPP11_OR_GREATER
+    using std::uint8_t;
+    using std::uint16_t;
+    using std::uint32_t;
+    using std::uint64_t;
+#else
+    typedef unsigned char      uint8_t;
+    typedef unsigned short int uint16_t;
+    typedef unsigned       int uint32_t;
+#endif
+
+namespace {
+
+// Prevent the compiler from computing a value once, or from discarding it:
+
+template< typename T >
+inline void do_not_optimize( T & value )
+{
+#if bench_HAVE_BUILTINS
+    __asm__ __volatile__( "" : "+r,m"( value ) : : "memory" );
+#else
+    static T volatile sink;
+    sink = value;
+    value = sink;
+#endif
+}
+
+inline void clobber_memory()
+{
+#if bench_HAVE_BUILTINS
+    __asm__ __volatile__( "" : : : "memory" );
+#elif defined( _MSC_VER )
+    _ReadWriteBarrier();
+#endif
+}
+
+// Wall clock and processor time in nanoseconds:
+
+inline double real_time_ns()
+{
+#if bit_CPP11_OR_GREATER
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#else
+    return 1e9 * static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+inline double cpu_time_ns()
+{
+    return 1e9 * static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+}
+
+// Deterministic pseudo-random values (xorshift64):
+
+class random_bits
+{
+public:
+    random_bits() : state_hi( 0x9e3779b9u ), state_lo( 0x7f4a7c15u ) {}
+
+    uint32_t next()
+    {
+        // xorshift on two 32-bit halves, C++98 has no 64-bit type:
+        uint32_t t = state_hi ^ ( state_hi << 11 );
+        state_hi = state_lo;
+        state_lo = state_lo ^ ( state_lo >> 19 ) ^ t ^ ( t >> 8 );
+        return state_lo;
+    }
+
+private:
+    uint32_t state_hi;
+    uint32_t state_lo;
+};
+
+template< typename T >
+T random_value( random_bits & rng )
+{
+    T result = 0;
+    for ( std::size_t i = 0; i < sizeof( T ); i += sizeof( uint32_t ) )
+    {
+        result = static_cast<T>( ( sizeof( T ) > sizeof( uint32_t ) ? result << 16 << 16 : 0 ) | rng.next() );
+    }
+    return result;
+}
+
+// Implementations; results converted to T to chain calls:
+
+template< typename T >
+inline T half( T x )
+{
+    // keep bit_ceil() within its precondition:
+    return static_cast<T>( x >> 1 );
+}
+
+// bit_cast() round-trips an unsigned integer via the floating point type of its size:
+
+template< typename T > struct float_of;
+template<> struct float_of< uint32_t > { typedef float  type; };
+#if bit_CPP11_OR_GREATER
+template<> struct float_of< uint64_t > { typedef double type; };
+#endif
+
+struct nonstd_impl
+{
+    static char const * name() { return "nonstd"; }
+
+    template< typename T > static T popcount      ( T x ) { return static_cast<T>( nonstd::popcount( x ) ); }
+    template< typename T > static T countl_zero   ( T x ) { return static_cast<T>( nonstd::countl_zero( x ) ); }
+    template< typename T > static T countl_one    ( T x ) { return static_cast<T>( nonstd::countl_one( x ) ); }
+    template< typename T > static T countr_zero   ( T x ) { return static_cast<T>( nonstd::countr_zero( x ) ); }
+    template< typename T > static T countr_one    ( T x ) { return static_cast<T>( nonstd::countr_one( x ) ); }
+    template< typename T > static T bit_width     ( T x ) { return static_cast<T>( nonstd::bit_width( x ) ); }
+    template< typename T > static T bit_floor     ( T x ) { return nonstd::bit_floor( x ); }
+    template< typename T > static T bit_ceil      ( T x ) { return nonstd::bit_ceil( half( x ) ); }
+    template< typename T > static T has_single_bit( T x ) { return static_cast<T>( nonstd::has_single_bit( x ) ); }
+    template< typename T > static T rotl          ( T x ) { return nonstd::rotl( x, 3 ); }
+    template< typename T > static T rotr          ( T x ) { return nonstd::rotr( x, 3 ); }
+    template< typename T > static T byteswap      ( T x ) { return nonstd::byteswap( x ); }
+    template< typename T > static T bit_cast      ( T x ) { return nonstd::bit_cast<T>( nonstd::bit_cast<typename float_of<T>::type>( x ) ); }
+};
+
+#if bench_HAVE_STD_BIT
+
+struct std_impl
+{
+    static char const * name() { return "std"; }
+
+    template< typename T > static T popcount      ( T x ) { return static_cast<T>( std::popcount( x ) ); }
+    template< typename T > static T countl_zero   ( T x ) { return static_cast<T>( std::countl_zero( x ) ); }
+    template< typename T > static T countl_one    ( T x ) { return static_cast<T>( std::countl_one( x ) ); }
+    template< typename T > static T countr_zero   ( T x ) { return static_cast<T>( std::countr_zero( x ) ); }
+    template< typename T > static T countr_one    ( T x ) { return static_cast<T>( std::countr_one( x ) ); }
+    template< typename T > static T bit_width     ( T x ) { return static_cast<T>( std::bit_width( x ) ); }
+    template< typename T > static T bit_floor     ( T x ) { return std::bit_floor( x ); }
+    template< typename T > static T bit_ceil      ( T x ) { return std::bit_ceil( half( x ) ); }
+    template< typename T > static T has_single_bit( T x ) { return static_cast<T>( std::has_single_bit( x ) ); }
+    template< typename T > static T rotl          ( T x ) { return std::rotl( x, 3 ); }
+    template< typename T > static T rotr          ( T x ) { return std::rotr( x, 3 ); }
+# if bench_HAVE_STD_BYTESWAP
+    template< typename T > static T byteswap      ( T x ) { return std::byteswap( x ); }
+# endif
+# if bench_HAVE_STD_BIT_CAST
+    template< typename T > static T bit_cast      ( T x ) { return std::bit_cast<T>( std::bit_cast<typename float_of<T>::type>( x ) ); }
+# endif
+};
+
+#endif // bench_HAVE_STD_BIT
+
+#if bench_HAVE_BUILTINS
+
+// widen to the argument type of the builtin:
+
+inline int builtin_clz_     ( unsigned int x ) { return __builtin_clz( x ); }
+inline int builtin_ctz_     ( unsigned int x ) { return __builtin_ctz( x ); }
+inline int builtin_popcount_( unsigned int x ) { return __builtin_popcount( x ); }
+
+# if bit_CPP11_OR_GREATER
+inline int builtin_clz_     ( uint64_t x ) { return __builtin_clzll( x ); }
+inline int builtin_ctz_     ( uint64_t x ) { return __builtin_ctzll( x ); }
+inline int builtin_popcount_( uint64_t x ) { return __builtin_popcountll( x ); }
+# endif
+
+template< typename T >
+struct builtin_arg
+{
+    typedef unsigned int type;
+};
+
+# if bit_CPP11_OR_GREATER
+template<>
+struct builtin_arg< uint64_t >
+{
+    typedef uint64_t type;
+};
+# endif
+
+template< typename T >
+inline int digits()
+{
+    return static_cast<int>( CHAR_BIT * sizeof( T ) );
+}
+
+template< typename T >
+inline int clz_( T x )
+{
+    typedef typename builtin_arg<T>::type U;
+    return x ? builtin_clz_( static_cast<U>( x ) ) - ( digits<U>() - digits<T>() ) : digits<T>();
+}
+
+template< typename T >
+inline int ctz_( T x )
+{
+    typedef typename builtin_arg<T>::type U;
+    return x ? builtin_ctz_( static_cast<U>( x ) ) : digits<T>();
+}
+
+inline uint8_t  bswap_( uint8_t  x ) { return x; }
+inline uint16_t bswap_( uint16_t x ) { return __builtin_bswap16( x ); }
+inline uint32_t bswap_( uint32_t x ) { return __builtin_bswap32( x ); }
+# if bit_CPP11_OR_GREATER
+inline uint64_t bswap_( uint64_t x ) { return __builtin_bswap64( x ); }
+# endif
+
+struct builtin_impl
+{
+    static char const * name() { return "builtin"; }
+
+    template< typename T > static T popcount   ( T x ) { return static_cast<T>( builtin_popcount_( static_cast<typename builtin_arg<T>::type>( x ) ) ); }
+    template< typename T > static T countl_zero( T x ) { return static_cast<T>( clz_( x ) ); }
+    template< typename T > static T countl_one ( T x ) { return static_cast<T>( clz_( static_cast<T>( ~x ) ) ); }
+    template< typename T > static T countr_zero( T x ) { return static_cast<T>( ctz_( x ) ); }
+    template< typename T > static T countr_one ( T x ) { return static_cast<T>( ctz_( static_cast<T>( ~x ) ) ); }
+    template< typename T > static T bit_width  ( T x ) { return static_cast<T>( digits<T>() - clz_( x ) ); }
+
+    template< typename T > static T bit_floor( T x )
+    {
+        return x ? static_cast<T>( T( 1 ) << ( digits<T>() - 1 - clz_( x ) ) ) : T( 0 );
+    }
+
+    template< typename T > static T bit_ceil( T x )
+    {
+        x = half( x );
+        return x <= 1u ? T( 1 ) : static_cast<T>( T( 1 ) << ( digits<T>() - clz_( static_cast<T>( x - 1u ) ) ) );
+    }
+
+    template< typename T > static T has_single_bit( T x )
+    {
+        return static_cast<T>( builtin_popcount_( static_cast<typename builtin_arg<T>::type>( x ) ) == 1 );
+    }
+
+    template< typename T > static T rotl( T x ) { return static_cast<T>( ( x << 3 ) | ( x >> ( digits<T>() - 3 ) ) ); }
+    template< typename T > static T rotr( T x ) { return static_cast<T>( ( x >> 3 ) | ( x << ( digits<T>() - 3 ) ) ); }
+
+    template< typename T > static T byteswap( T x ) { return bswap_( x ); }
+
+# if bit_HAVE_BUILTIN_BIT_CAST && bit_CPP11_OR_GREATER
+    template< typename T > static T bit_cast( T x )
+    {
+        return __builtin_bit_cast( T, __builtin_bit_cast( typename float_of<T>::type, x ) );
+    }
+# endif
+};
+
+#endif // bench_HAVE_BUILTINS
+
+// Operations, for a given implementation:
+
+#define bench_OPERATION( op )                                         \
+    template< typename Impl >                                         \
+    struct op##_op                                                    \
+    {                                                                 \
+        static char const * name() { return #op; }                    \
+        template< typename T > static T apply( T x ) { return Impl::op( x ); } \
+    };
+
+bench_OPERATION( popcount )
+bench_OPERATION( countl_zero )
+bench_OPERATION( countl_one )
+bench_OPERATION( countr_zero )
+bench_OPERATION( countr_one )
+bench_OPERATION( bit_width )
+bench_OPERATION( bit_floor )
+bench_OPERATION( bit_ceil )
+bench_OPERATION( has_single_bit )
+bench_OPERATION( rotl )
+bench_OPERATION( rotr )
+bench_OPERATION( byteswap )
+bench_OPERATION( bit_cast )
+
+#undef bench_OPERATION
+
+// Benchmark kernels, performing iterations calls:
+
+const std::size_t block_size = 1024;    // power of 2
+
+template< typename Op, typename T >
+void run_latency( std::size_t iterations )
+{
+    // each call depends on the result of the previous one:
+
+    random_bits rng;
+    T x = random_value<T>( rng );
+
+    for ( std::size_t i = 0; i < iterations; ++i )
+    {
+        x = static_cast<T>( x + Op::apply( x ) + 1u );
+    }
+    do_not_optimize( x );
+}
+
+template< typename Op, typename T >
+void run_throughput( std::size_t iterations )
+{
+    // independent calls over a block of values:
+
+    static std::vector<T> values;
+
+    if ( values.empty() )
+    {
+        random_bits rng;
+        for ( std::size_t i = 0; i < block_size; ++i )
+            values.push_back( random_value<T>( rng ) );
+    }
+
+    T const * data = &values[0];
+    T sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += block_size )
+    {
+        for ( std::size_t i = 0; i < block_size; ++i )
+        {
+            sum = static_cast<T>( sum + Op::apply( data[i] ) );
+        }
+        clobber_memory();
+    }
+    do_not_optimize( sum );
+}
+
+#if !bit_CONFIG_STRICT
+
+// Bulk extensions, performing iterations words:
+
+typedef unsigned int word_t;
+
+inline std::vector<word_t> & bulk_data()
+{
+    static std::vector<word_t> data;
+
+    if ( data.empty() )
+    {
+        random_bits rng;
+        for ( std::size_t i = 0; i < 16 * block_size; ++i )
+            data.push_back( rng.next() );
+    }
+    return data;
+}
+
+template< typename Impl >
+void run_popcount_n( std::size_t iterations )
+{
+    std::vector<word_t> & data = bulk_data();
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += data.size() )
+    {
+        sum += Impl::popcount_n( &data[0], data.size() );
+        clobber_memory();
+    }
+    do_not_optimize( sum );
+}
+
+// Hamming distance between the two halves of the bulk data:
+
+template< typename Impl >
+void run_xor_popcount_n( std::size_t iterations )
+{
+    std::vector<word_t> & data = bulk_data();
+    std::size_t const half = data.size() / 2;
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += half )
+    {
+        sum += Impl::xor_popcount_n( &data[0], &data[half], half );
+        clobber_memory();
+    }
+    do_not_optimize( sum );
+}
+
+template< typename Impl >
+void run_byteswap_n( std::size_t iterations )
+{
+    std::vector<word_t> & data = bulk_data();
+
+    for ( std::size_t done = 0; done < iterations; done += data.size() )
+    {
+        Impl::byteswap_n( &data[0], data.size() );
+        clobber_memory();
+    }
+}
+
+// varints of mostly 1 and 2 bytes, as typical for protobuf messages:
+
+inline std::vector<unsigned char> & varint_data()
+{
+    static std::vector<unsigned char> data;
+
+    if ( data.empty() )
+    {
+        std::vector<word_t> const & words = bulk_data();
+        unsigned char buf[8];
+
+        for ( std::size_t i = 0; i < words.size(); ++i )
+        {
+            word_t const v = words[i] >> ( 18 + words[i] % 14 );
+            data.insert( data.end(), buf, buf + nonstd::varint_encode( v, buf ) );
+        }
+    }
+    return data;
+}
+
+template< typename Impl >
+void run_varint_decode_n( std::size_t iterations )
+{
+    std::vector<unsigned char> & data = varint_data();
+    static std::vector<word_t> out( bulk_data().size() );
+
+    for ( std::size_t done = 0; done < iterations; done += out.size() )
+    {
+        Impl::varint_decode_n( &data[0], data.size(), &out[0], out.size() );
+        clobber_memory();
+    }
+}
+
+// bitpack() and bitunpack() at a given width, performing iterations values:
+
+template< int Bits >
+void run_bitpack( std::size_t iterations )
+{
+    std::vector<word_t> & data = bulk_data();
+    static std::vector<word_t> out( data.size() );
+
+    for ( std::size_t done = 0; done < iterations; done += data.size() )
+    {
+        nonstd::bitpack( &data[0], data.size(), Bits, &out[0] );
+        clobber_memory();
+    }
+}
+
+template< int Bits >
+void run_bitunpack( std::size_t iterations )
+{
+    std::vector<word_t> & data = bulk_data();
+    static std::vector<word_t> out( data.size() );
+
+    for ( std::size_t done = 0; done < iterations; done += data.size() )
+    {
+        nonstd::bitunpack( &data[0], data.size(), Bits, &out[0] );
+        clobber_memory();
+    }
+}
+
+struct bulk_nonstd
+{
+    static char const * name() { return "nonstd"; }
+
+    static std::size_t popcount_n( word_t const * data, std::size_t n ) { return nonstd::popcount( data, n ); }
+    static std::size_t xor_popcount_n( word_t const * a, word_t const * b, std::size_t n ) { return nonstd::xor_popcount( a, b, n ); }
+    static void        byteswap_n( word_t * data, std::size_t n ) { nonstd::byteswap_n( data, n ); }
+
+    static std::size_t varint_decode_n( unsigned char const * in, std::size_t size, word_t * out, std::size_t n )
+    {
+        return nonstd::varint_decode_n( in, size, out, n );
+    }
+};
+
+struct bulk_loop
+{
+    static char const * name() { return "loop"; }
+
+    static std::size_t popcount_n( word_t const * data, std::size_t n )
+    {
+        std::size_t sum = 0;
+        for ( std::size_t i = 0; i < n; ++i )
+            sum += static_cast<std::size_t>( nonstd::popcount( data[i] ) );
+        return sum;
+    }
+
+    static std::size_t xor_popcount_n( word_t const * a, word_t const * b, std::size_t n )
+    {
+        std::size_t sum = 0;
+        for ( std::size_t i = 0; i < n; ++i )
+            sum += static_cast<std::size_t>( nonstd::popcount( static_cast<word_t>( a[i] ^ b[i] ) ) );
+        return sum;
+    }
+
+    static void byteswap_n( word_t * data, std::size_t n )
+    {
+        for ( std::size_t i = 0; i < n; ++i )
+            data[i] = nonstd::byteswap( data[i] );
+    }
+
+    static std::size_t varint_decode_n( unsigned char const * in, std::size_t size, word_t * out, std::size_t n )
+    {
+        std::size_t pos = 0;
+        for ( std::size_t i = 0; i < n; ++i )
+            pos += nonstd::varint_decode( in + pos, size - pos, out[i] );
+        return pos;
+    }
+};
+
+#if bit_CPP11_OR_GREATER
+
+// bit_vector versus std::vector<bool>, performing iterations bits:
+
+const std::size_t vector_bits = 64 * 1024;
+
+template< typename V >
+V make_bits( std::size_t n, uint32_t seed_skip )
+{
+    random_bits rng;
+    for ( uint32_t i = 0; i < seed_skip; ++i )
+        rng.next();
+
+    V v( n );
+    for ( std::size_t i = 0; i < n; ++i )
+        if ( rng.next() & 1u )
+            v.set( i );
+    return v;
+}
+
+struct vector_bool : std::vector<bool>
+{
+    explicit vector_bool( std::size_t n ) : std::vector<bool>( n ) {}
+    void set( std::size_t i ) { (*this)[i] = true; }
+};
+
+struct bits_nonstd
+{
+    typedef nonstd::bit_vector type;
+    static char const * name() { return "nonstd"; }
+
+    static void and_assign( type & a, type const & b ) { a &= b; }
+    static std::size_t count( type const & a ) { return a.count(); }
+};
+
+struct bits_vector_bool
+{
+    typedef vector_bool type;
+    static char const * name() { return "vector_bool"; }
+
+    static void and_assign( type & a, type const & b )
+    {
+        for ( std::size_t i = 0; i < a.size(); ++i )
+            a[i] = a[i] && b[i];
+    }
+
+    static std::size_t count( type const & a )
+    {
+        std::size_t sum = 0;
+        for ( std::size_t i = 0; i < a.size(); ++i )
+            sum += a[i];
+        return sum;
+    }
+};
+
+template< typename Impl >
+void run_bits_and( std::size_t iterations )
+{
+    typename Impl::type a = make_bits<typename Impl::type>( vector_bits, 0 );
+    typename Impl::type const b = make_bits<typename Impl::type>( vector_bits, 1 );
+
+    for ( std::size_t done = 0; done < iterations; done += vector_bits )
+    {
+        Impl::and_assign( a, b );
+        clobber_memory();
+    }
+
+    std::size_t sum = Impl::count( a );
+    do_not_optimize( sum );
+}
+
+template< typename Impl >
+void run_bits_count( std::size_t iterations )
+{
+    typename Impl::type const a = make_bits<typename Impl::type>( vector_bits, 0 );
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += vector_bits )
+    {
+        sum += Impl::count( a );
+        clobber_memory();
+    }
+    do_not_optimize( sum );
+}
+
+// bitwise_and_n() over arrays beyond the last level cache, fused and on 1 or all threads,
+// versus and followed by popcount(data, n), performing iterations words:
+
+std::size_t const large_words = std::size_t( 1 ) << 22;
+
+std::vector<uint64_t> & large_data( int which )
+{
+    static std::vector<uint64_t> data[2];
+
+    if ( data[which].empty() )
+    {
+        random_bits rng;
+        data[which].resize( large_words );
+
+        for ( std::size_t i = 0; i < large_words; ++i )
+            data[which][i] = ( uint64_t( rng.next() ) << 32 | rng.next() ) | uint64_t( which );
+    }
+    return data[which];
+}
+
+template< unsigned Threads >
+void run_and_count( std::size_t iterations )
+{
+    std::vector<uint64_t> & a = large_data( 0 );
+    std::vector<uint64_t> & b = large_data( 1 );
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += large_words )
+    {
+        sum += nonstd::bitwise_and_n( &a[0], &b[0], large_words, Threads );
+    }
+    do_not_optimize( sum );
+}
+
+void run_and_then_count( std::size_t iterations )
+{
+    std::vector<uint64_t> & a = large_data( 0 );
+    std::vector<uint64_t> & b = large_data( 1 );
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += large_words )
+    {
+        for ( std::size_t i = 0; i < large_words; ++i )
+            a[i] &= b[i];
+
+        sum += nonstd::popcount( &a[0], large_words );
+    }
+    do_not_optimize( sum );
+}
+
+// Hamming distance of a query to 2^12 fingerprints of Bits bits, top 10 of them,
+// and a loop of xor and popcount per fingerprint, performing iterations fingerprints:
+
+std::size_t const fingerprints = std::size_t( 1 ) << 12;
+
+template< std::size_t Bits >
+void run_hamming_distance_n( std::size_t iterations )
+{
+    std::vector<uint64_t> & f = large_data( 0 );
+    std::vector<uint64_t> & q = large_data( 1 );
+    static std::vector<unsigned> distances( fingerprints );
+
+    for ( std::size_t done = 0; done < iterations; done += fingerprints )
+    {
+        nonstd::hamming_distance_n<Bits>( &q[0], &f[0], fingerprints, &distances[0] );
+        clobber_memory();
+    }
+    do_not_optimize( distances[0] );
+}
+
+template< std::size_t Bits >
+void run_hamming_loop( std::size_t iterations )
+{
+    std::vector<uint64_t> & f = large_data( 0 );
+    std::vector<uint64_t> & q = large_data( 1 );
+    static std::vector<unsigned> distances( fingerprints );
+
+    for ( std::size_t done = 0; done < iterations; done += fingerprints )
+    {
+        for ( std::size_t i = 0; i < fingerprints; ++i )
+        {
+            unsigned d = 0;
+            for ( std::size_t w = 0; w < Bits / 64; ++w )
+                d += static_cast<unsigned>( nonstd::popcount( q[w] ^ f[i * ( Bits / 64 ) + w] ) );
+            distances[i] = d;
+        }
+        clobber_memory();
+    }
+    do_not_optimize( distances[0] );
+}
+
+template< std::size_t Bits >
+void run_hamming_top_k( std::size_t iterations )
+{
+    std::vector<uint64_t> & f = large_data( 0 );
+    std::vector<uint64_t> & q = large_data( 1 );
+    nonstd::hamming_match top[10];
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += fingerprints )
+    {
+        sum += nonstd::hamming_top_k<Bits>( &q[0], &f[0], fingerprints, 10, top );
+        sum += top[0].index;
+    }
+    do_not_optimize( sum );
+}
+
+// bit_reader and bit_writer, fields of 1 to 24 bits, performing iterations bytes:
+
+const std::size_t stream_bytes = 64 * 1024;
+
+template< typename Reader >
+void run_bit_read( std::size_t iterations )
+{
+    std::vector<word_t> & data = bulk_data();
+    std::size_t const limit = 8 * stream_bytes - 64;
+    uint64_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += stream_bytes )
+    {
+        Reader in( &data[0], stream_bytes );
+
+        for ( int n = 1; in.position() < limit; n = n % 24 + 1 )
+        {
+            sum += in.read( n );
+        }
+    }
+    do_not_optimize( sum );
+}
+
+template< typename Writer >
+void run_bit_write( std::size_t iterations )
+{
+    static std::vector<unsigned char> out( stream_bytes );
+    std::size_t const limit = 8 * stream_bytes - 64;
+
+    for ( std::size_t done = 0; done < iterations; done += stream_bytes )
+    {
+        Writer w( &out[0], out.size() );
+
+        for ( int n = 1; w.position() < limit; n = n % 24 + 1 )
+        {
+            w.write( static_cast<uint64_t>( done ) + static_cast<uint64_t>( n ), n );
+        }
+        w.finish();
+        clobber_memory();
+    }
+}
+
+// elias_fano access(), next_geq() and iteration over a sequence with gaps below 1024, performing iterations values:
+
+nonstd::elias_fano const & elias_fano_data()
+{
+    static nonstd::elias_fano ef;
+
+    if ( ef.empty() )
+    {
+        std::vector<word_t> const & words = bulk_data();
+        std::vector<uint64_t> values( words.size() );
+
+        for ( std::size_t i = 0; i < words.size(); ++i )
+        {
+            values[i] = ( i > 0 ? values[i - 1] : 0 ) + words[i] % 1024;
+        }
+        ef = nonstd::elias_fano( &values[0], values.size() );
+    }
+    return ef;
+}
+
+void run_elias_fano_access( std::size_t iterations )
+{
+    nonstd::elias_fano const & ef = elias_fano_data();
+    std::vector<word_t> & words = bulk_data();
+    uint64_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += words.size() )
+    {
+        for ( std::size_t i = 0; i < words.size(); ++i )
+        {
+            sum += ef[ words[i] % ef.size() ];
+        }
+    }
+    do_not_optimize( sum );
+}
+
+void run_elias_fano_next_geq( std::size_t iterations )
+{
+    nonstd::elias_fano const & ef = elias_fano_data();
+    std::vector<word_t> & words = bulk_data();
+    uint64_t const back = ef[ ef.size() - 1 ];
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += words.size() )
+    {
+        for ( std::size_t i = 0; i < words.size(); ++i )
+        {
+            sum += ef.next_geq( words[i] % back );
+        }
+    }
+    do_not_optimize( sum );
+}
+
+void run_elias_fano_iterate( std::size_t iterations )
+{
+    nonstd::elias_fano const & ef = elias_fano_data();
+    uint64_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += ef.size() )
+    {
+        for ( nonstd::elias_fano::const_iterator pos = ef.begin(); pos != ef.end(); ++pos )
+        {
+            sum += *pos;
+        }
+    }
+    do_not_optimize( sum );
+}
+
+// roaring_bitmap and, or of sparse and dense sets, performing iterations input values:
+
+std::size_t const roaring_values = 1u << 18;
+
+nonstd::roaring_bitmap const & roaring_data( int which )
+{
+    static nonstd::roaring_bitmap sets[2];
+
+    if ( sets[0].empty() )
+    {
+        std::vector<word_t> const & words = bulk_data();
+
+        for ( std::size_t i = 0; i < roaring_values; ++i )
+        {
+            // keys below 2 hold dense containers, the others sparse ones:
+
+            word_t const x = words[ i % words.size() ] ^ static_cast<word_t>( i * 2654435761u );
+
+            sets[i % 2].add( x % ( i < roaring_values / 2 ? 0x20000u : 0x4000000u ) );
+        }
+    }
+    return sets[which];
+}
+
+template< typename Op >
+void run_roaring( std::size_t iterations )
+{
+    nonstd::roaring_bitmap const & a = roaring_data( 0 );
+    nonstd::roaring_bitmap const & b = roaring_data( 1 );
+    std::size_t sum = 0;
+
+    for ( std::size_t done = 0; done < iterations; done += roaring_values )
+    {
+        sum += Op()( a, b ).cardinality();
+    }
+    do_not_optimize( sum );
+}
+
+struct roaring_and { nonstd::roaring_bitmap operator()( nonstd::roaring_bitmap const & a, nonstd::roaring_bitmap const & b ) const { return a & b; } };
+struct roaring_or  { nonstd::roaring_bitmap operator()( nonstd::roaring_bitmap const & a, nonstd::roaring_bitmap const & b ) const { return a | b; } };
+
+#endif // bit_CPP11_OR_GREATER
+#endif // !bit_CONFIG_STRICT
+
+// Registry:
+
+typedef void (*bench_function)( std::size_t iterations );
+
+struct benchmark
+{
+    std::string    name;
+    bench_function function;
+    std::size_t    granularity;     // iterations are performed in multiples of this
+};
+
+std::vector<benchmark> & registry()
+{
+    static std::vector<benchmark> list;
+    return list;
+}
+
+void add( std::string const & name, bench_function function, std::size_t granularity )
+{
+    benchmark b = { name, function, granularity };
+    registry().push_back( b );
+}
+
+template< template< typename > class Op, typename Impl, typename T >
+void add_operation( char const * type )
+{
+    std::string const name = std::string( Op<Impl>::name() ) + "<" + type + ">/" + Impl::name();
+
+    add( name + "/latency"   , &run_latency   < Op<Impl>, T >, 1 );
+    add( name + "/throughput", &run_throughput< Op<Impl>, T >, block_size );
+}
+
+template< typename Impl, typename T >
+void add_operations( char const * type )
+{
+    add_operation< popcount_op      , Impl, T >( type );
+    add_operation< countl_zero_op   , Impl, T >( type );
+    add_operation< countl_one_op    , Impl, T >( type );
+    add_operation< countr_zero_op   , Impl, T >( type );
+    add_operation< countr_one_op    , Impl, T >( type );
+    add_operation< bit_width_op     , Impl, T >( type );
+    add_operation< bit_floor_op     , Impl, T >( type );
+    add_operation< bit_ceil_op      , Impl, T >( type );
+    add_operation< has_single_bit_op, Impl, T >( type );
+    add_operation< rotl_op          , Impl, T >( type );
+    add_operation< rotr_op          , Impl, T >( type );
+}
+
+template< typename Impl >
+void add_implementation()
+{
+    add_operations< Impl, uint8_t  >( "uint8"  );
+    add_operations< Impl, uint16_t >( "uint16" );
+    add_operations< Impl, uint32_t >( "uint32" );
+#if bit_CPP11_OR_GREATER
+    add_operations< Impl, uint64_t >( "uint64" );
+#endif
+}
+
+template< typename Impl >
+void add_byteswap()
+{
+    add_operation< byteswap_op, Impl, uint8_t  >( "uint8"  );
+    add_operation< byteswap_op, Impl, uint16_t >( "uint16" );
+    add_operation< byteswap_op, Impl, uint32_t >( "uint32" );
+#if bit_CPP11_OR_GREATER
+    add_operation< byteswap_op, Impl, uint64_t >( "uint64" );
+#endif
+}
+
+template< typename Impl >
+void add_bit_cast()
+{
+#if bit_CPP11_OR_GREATER
+    add_operation< bit_cast_op, Impl, uint32_t >( "uint32" );
+    add_operation< bit_cast_op, Impl, uint64_t >( "uint64" );
+#endif
+}
+
+void register_benchmarks()
+{
+    add_implementation< nonstd_impl >();
+    add_byteswap      < nonstd_impl >();
+    add_bit_cast      < nonstd_impl >();
+
+#if bench_HAVE_STD_BIT
+    add_implementation< std_impl >();
+# if bench_HAVE_STD_BYTESWAP
+    add_byteswap      < std_impl >();
+# endif
+# if bench_HAVE_STD_BIT_CAST
+    add_bit_cast      < std_impl >();
+# endif
+#endif
+
+#if bench_HAVE_BUILTINS
+    add_implementation< builtin_impl >();
+    add_byteswap      < builtin_impl >();
+# if bit_HAVE_BUILTIN_BIT_CAST
+    add_bit_cast      < builtin_impl >();
+# endif
+#endif
+
+#if !bit_CONFIG_STRICT
+    std::size_t const n = bulk_data().size();
+
+    add( std::string( "popcount_n<uint32>/" ) + bulk_nonstd::name(), &run_popcount_n< bulk_nonstd >, n );
+    add( std::string( "popcount_n<uint32>/" ) + bulk_loop::name()  , &run_popcount_n< bulk_loop   >, n );
+    add( std::string( "xor_popcount<uint32>/" ) + bulk_nonstd::name(), &run_xor_popcount_n< bulk_nonstd >, n / 2 );
+    add( std::string( "xor_popcount<uint32>/" ) + bulk_loop::name()  , &run_xor_popcount_n< bulk_loop   >, n / 2 );
+    add( std::string( "byteswap_n<uint32>/" ) + bulk_nonstd::name(), &run_byteswap_n< bulk_nonstd >, n );
+    add( std::string( "byteswap_n<uint32>/" ) + bulk_loop::name()  , &run_byteswap_n< bulk_loop   >, n );
+    add( std::string( "varint_decode_n<uint32>/" ) + bulk_nonstd::name(), &run_varint_decode_n< bulk_nonstd >, n );
+    add( std::string( "varint_decode_n<uint32>/" ) + bulk_loop::name()  , &run_varint_decode_n< bulk_loop   >, n );
+
+    add( "bitpack<uint32>/5/nonstd"   , &run_bitpack  <  5 >, n );
+    add( "bitpack<uint32>/13/nonstd"  , &run_bitpack  < 13 >, n );
+    add( "bitpack<uint32>/27/nonstd"  , &run_bitpack  < 27 >, n );
+    add( "bitunpack<uint32>/5/nonstd" , &run_bitunpack<  5 >, n );
+    add( "bitunpack<uint32>/13/nonstd", &run_bitunpack< 13 >, n );
+    add( "bitunpack<uint32>/27/nonstd", &run_bitunpack< 27 >, n );
+
+# if bit_CPP11_OR_GREATER
+    add( std::string( "bit_vector_and/" )   + bits_nonstd::name()     , &run_bits_and  < bits_nonstd      >, vector_bits );
+    add( std::string( "bit_vector_and/" )   + bits_vector_bool::name(), &run_bits_and  < bits_vector_bool >, vector_bits );
+    add( std::string( "bit_vector_count/" ) + bits_nonstd::name()     , &run_bits_count< bits_nonstd      >, vector_bits );
+    add( std::string( "bit_vector_count/" ) + bits_vector_bool::name(), &run_bits_count< bits_vector_bool >, vector_bits );
+
+    add( "and_count/fused/1/nonstd"  , &run_and_count< 1 >  , large_words );
+    add( "and_count/fused/all/nonstd", &run_and_count< 0 >  , large_words );
+    add( "and_count/and_then_count"  , &run_and_then_count  , large_words );
+
+    add( "hamming_distance_n<256>/nonstd", &run_hamming_distance_n< 256 >, fingerprints );
+    add( "hamming_distance_n<256>/loop"  , &run_hamming_loop      < 256 >, fingerprints );
+    add( "hamming_distance_n<512>/nonstd", &run_hamming_distance_n< 512 >, fingerprints );
+    add( "hamming_distance_n<512>/loop"  , &run_hamming_loop      < 512 >, fingerprints );
+    add( "hamming_top_k<256>/10/nonstd"  , &run_hamming_top_k     < 256 >, fingerprints );
+
+    add( "bit_reader/big/bytes"   , &run_bit_read < nonstd::big_bit_reader    >, stream_bytes );
+    add( "bit_reader/little/bytes", &run_bit_read < nonstd::little_bit_reader >, stream_bytes );
+    add( "bit_writer/big/bytes"   , &run_bit_write< nonstd::big_bit_writer    >, stream_bytes );
+    add( "bit_writer/little/bytes", &run_bit_write< nonstd::little_bit_writer >, stream_bytes );
+
+    add( "elias_fano/access/nonstd"  , &run_elias_fano_access  , n );
+    add( "elias_fano/next_geq/nonstd", &run_elias_fano_next_geq, n );
+    add( "elias_fano/iterate/nonstd" , &run_elias_fano_iterate , n );
+
+    add( "roaring_bitmap/and/nonstd", &run_roaring< roaring_and >, roaring_values );
+    add( "roaring_bitmap/or/nonstd" , &run_roaring< roaring_or  >, roaring_values );
+# endif
+#endif
+}
+
+// Running:
+
+struct options
+{
+    options() : json( false ), min_time( 0.5 ), filter(), out() {}
+
+    bool        json;
+    double      min_time;   // seconds
+    std::string filter;
+    std::string out;
+};
+
+struct result
+{
+    std::string name;
+    std::size_t iterations;
+    double      real_time;  // ns per iteration
+    double      cpu_time;   // ns per iteration
+};
+
+result measure( benchmark const & b, double min_time )
+{
+    double const min_ns = 1e9 * min_time;
+    std::size_t iterations = b.granularity;
+
+    for ( ;; )
+    {
+        double const real_start = real_time_ns();
+        double const cpu_start  = cpu_time_ns();
+
+        b.function( iterations );
+
+        double const real_ns = real_time_ns() - real_start;
+        double const cpu_ns  = cpu_time_ns()  - cpu_start;
+
+        if ( real_ns >= min_ns || iterations >= std::size_t( 1 ) << 30 )
+        {
+            result r = { b.name, iterations, real_ns / double( iterations ), cpu_ns / double( iterations ) };
+            return r;
+        }
+
+        // grow as Google Benchmark does, by at most a factor of 10:
+
+        double const factor = real_ns > 0 ? 1.4 * min_ns / real_ns : 10.0;
+
+        std::size_t const next = static_cast<std::size_t>( double( iterations ) * ( factor > 10.0 ? 10.0 : factor < 2.0 ? 2.0 : factor ) );
+
+        iterations = ( next + b.granularity - 1 ) / b.granularity * b.granularity;
+    }
+}
+
+std::string json_escape( std::string const & text )
+{
+    std::string result;
+    for ( std::size_t i = 0; i < text.size(); ++i )
+    {
+        if ( text[i] == '"' || text[i] == '\\' )
+            result += '\\';
+        result += text[i];
+    }
+    return result;
+}
+
+std::string date_time()
+{
+    char buffer[32];
+    std::time_t const now = std::time( 0 );
+    std::strftime( buffer, sizeof( buffer ), "%Y-%m-%dT%H:%M:%S", std::localtime( &now ) );
+    return buffer;
+}
+
+void write_json( std::ostream & os, std::vector<result> const & results, char const * executable )
+{
+    os << "{\n"
+       << "  \"context\": {\n"
+       << "    \"date\": \"" << date_time() << "\",\n"
+       << "    \"executable\": \"" << json_escape( executable ) << "\",\n"
+#ifdef NDEBUG
+       << "    \"library_build_type\": \"release\",\n"
+#else
+       << "    \"library_build_type\": \"debug\",\n"
+#endif
+       << "    \"cplusplus\": " << bit_CPLUSPLUS << ",\n"
+       << "    \"bit_uses_std_bit\": " << ( bit_USES_STD_BIT ? "true" : "false" ) << ",\n"
+       << "    \"have_std_bit\": " << ( bench_HAVE_STD_BIT ? "true" : "false" ) << ",\n"
+       << "    \"have_builtins\": " << ( bench_HAVE_BUILTINS ? "true" : "false" )
+#if !bit_CONFIG_STRICT && bit_CPP11_OR_GREATER
+       << ",\n"
+       << "    \"kernels\": {\n"
+       << "      \"popcount\": \""   << nonstd::selected_kernels().popcount   << "\",\n"
+       << "      \"popcount_n\": \"" << nonstd::selected_kernels().popcount_n << "\",\n"
+       << "      \"byteswap_n\": \"" << nonstd::selected_kernels().byteswap_n << "\",\n"
+       << "      \"bitwise_n\": \""  << nonstd::selected_kernels().bitwise_n  << "\",\n"
+       << "      \"pdep\": \""       << nonstd::selected_kernels().pdep       << "\",\n"
+       << "      \"varint_n\": \""   << nonstd::selected_kernels().varint_n   << "\"\n"
+       << "    }"
+#endif
+       << "\n  },\n"
+       << "  \"benchmarks\": [";
+
+    for ( std::size_t i = 0; i < results.size(); ++i )
+    {
+        result const & r = results[i];
+
+        os << ( i ? ",\n" : "\n" )
+           << "    {\n"
+           << "      \"name\": \""       << json_escape( r.name ) << "\",\n"
+           << "      \"run_name\": \""   << json_escape( r.name ) << "\",\n"
+           << "      \"run_type\": \"iteration\",\n"
+           << "      \"iterations\": "   << r.iterations << ",\n"
+           << "      \"real_time\": "    << r.real_time  << ",\n"
+           << "      \"cpu_time\": "     << r.cpu_time   << ",\n"
+           << "      \"time_unit\": \"ns\"\n"
+           << "    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+void write_console_header( std::ostream & os )
+{
+    char line[128];
+    std::sprintf( line, "%-44s %12s %12s %12s\n", "Benchmark", "Time", "CPU", "Iterations" );
+    os << line << std::string( 83, '-' ) << "\n";
+}
+
+void write_console( std::ostream & os, result const & r )
+{
+    char line[128];
+    std::sprintf( line, "%-44s %9.2f ns %9.2f ns %12lu\n", r.name.c_str(), r.real_time, r.cpu_time, static_cast<unsigned long>( r.iterations ) );
+    os << line << std::flush;
+}
+
+bool starts_with( std::string const & text, char const * prefix, std::string & rest )
+{
+    std::size_t const n = std::strlen( prefix );
+    if ( text.compare( 0, n, prefix ) != 0 )
+        return false;
+    rest = text.substr( n );
+    return true;
+}
+
+int usage( char const * program )
+{
+    std::cout
+        << "Usage: " << program << " [option...]\n"
+        << "\n"
+        << "  --benchmark_filter=<text>      run benchmarks whose name contains text\n"
+        << "  --benchmark_min_time=<sec>     minimum time per benchmark [0.5]\n"
+        << "  --benchmark_format=<fmt>       console or json [console]\n"
+        << "  --benchmark_out=<file>         also write JSON to file\n"
+        << "  --benchmark_list_tests         list benchmark names\n"
+        << "  -h, --help                     this help message\n";
+    return 0;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    register_benchmarks();
+
+    options opt;
+    bool list = false;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string const arg = argv[i];
+        std::string value;
+
+        if      ( arg == "-h" || arg == "--help"                    ) { return usage( argv[0] ); }
+        else if ( arg == "--benchmark_list_tests"                   ) { list = true; }
+        else if ( starts_with( arg, "--benchmark_filter=",   value ) ) { opt.filter = value; }
+        else if ( starts_with( arg, "--benchmark_min_time=", value ) ) { opt.min_time = std::atof( value.c_str() ); }
+        else if ( starts_with( arg, "--benchmark_format=",   value ) ) { opt.json = value == "json"; }
+        else if ( starts_with( arg, "--benchmark_out=",      value ) ) { opt.out = value; }
+        else
+        {
+            std::cerr << argv[0] << ": unknown option '" << arg << "'\n";
+            return 1;
+        }
+    }
+
+    std::vector<result> results;
+
+    if ( !opt.json && !list )
+        write_console_header( std::cout );
+
+    for ( std::size_t i = 0; i < registry().size(); ++i )
+    {
+        benchmark const & b = registry()[i];
+
+        if ( b.name.find( opt.filter ) == std::string::npos )
+            continue;
+
+        if ( list )
+        {
+            std::cout << b.name << "\n";
+            continue;
+        }
+
+        results.push_back( measure( b, opt.min_time ) );
+
+        if ( !opt.json )
+            write_console( std::cout, results.back() );
+    }
+
+    if ( opt.json )
+        write_json( std::cout, results, argv[0] );
+
+    if ( !opt.out.empty() )
+    {
+        std::ofstream os( opt.out.c_str() );
+        write_json( os, results, argv[0] );
+
+        if ( !os )
+        {
+            std::cerr << argv[0] << ": cannot write '" << opt.out << "'\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// g++ -std=c++17 -O2 -Wall -I../include -o bit.b.exe bit.b.cpp && bit.b.exe --benchmark_min_time=0.1
@@ -36,6 +36,13 @@ CASE( "bit-lite configuration" "[.bit][.config]" )
     bit_PRESENT( bit_BIT_NONSTD );
     bit_PRESENT( bit_BIT_STD );
     bit_PRESENT( bit_CONFIG_SELECT_BIT );
+    bit_PRESENT( bit_CONFIG_NO_INTRINSICS );
+    bit_PRESENT( bit_CONFIG_RUNTIME_DISPATCH );
+    bit_PRESENT( bit_CONFIG_NO_THREADS );
+    bit_PRESENT( bit_POPCOUNT_DEFAULT );
+    bit_PRESENT( bit_POPCOUNT_INTRINSIC );
+    bit_PRESENT( bit_POPCOUNT_SWAR );
+    bit_PRESENT( bit_CONFIG_SELECT_POPCOUNT );
     // bit_PRESENT( bit_CONFIG_NO_EXCEPTIONS );
     bit_PRESENT( bit_CPLUSPLUS );
 }
@@ -62,6 +69,34 @@ CASE( "Compiler version" "[.compiler]" )
 #endif
 }
 
+CASE( "Presence of compiler intrinsics" "[.intrinsics]" )
+{
+#if bit_USES_STD_BIT
+    std::cout << "(Presence of compiler intrinsics not available: using standard <bit>)\n";
+#else
+    bit_PRESENT( bit_HAVE_BUILTIN_BITOPS );
+    bit_PRESENT( bit_HAVE_MSVC_BITSCAN );
+    bit_PRESENT( bit_HAVE_MSVC_BITSCAN64 );
+    bit_PRESENT( bit_HAVE_MSVC_LZCNT );
+    bit_PRESENT( bit_HAVE_INTRINSIC_COUNT );
+    bit_PRESENT( bit_HAVE_BUILTIN_BSWAP );
+    bit_PRESENT( bit_HAVE_MSVC_BYTESWAP );
+    bit_PRESENT( bit_HAVE_CONSTEXPR_INTRINSICS );
+    bit_PRESENT( bit_HAVE_MSVC_ROTATE );
+    bit_PRESENT( bit_HAVE_MSVC_POPCNT );
+    bit_PRESENT( bit_HAVE_POPCOUNT_INTRINSIC );
+    bit_PRESENT( bit_HAVE_POPCOUNT_INSTRUCTION );
+    bit_PRESENT( bit_USES_POPCOUNT_INTRINSIC );
+    bit_PRESENT( bit_HAVE_SSE2 );
+    bit_PRESENT( bit_HAVE_SSSE3 );
+    bit_PRESENT( bit_HAVE_AVX2 );
+    bit_PRESENT( bit_HAVE_AVX512_VPOPCNTDQ );
+    bit_PRESENT( bit_HAVE_BMI2 );
+    bit_PRESENT( bit_HAVE_CPUID );
+    bit_PRESENT( bit_USES_RUNTIME_DISPATCH );
+#endif
+}
+
 CASE( "Presence of C++ language features" "[.stdlanguage]" )
 {
 #if bit_USES_STD_BIT
@@ -75,6 +110,10 @@ CASE( "Presence of C++ language features" "[.stdlanguage]" )
     bit_PRESENT( bit_HAVE_CONSTEXPR_11 );
     bit_PRESENT( bit_HAVE_CONSTEXPR_14 );
     bit_PRESENT( bit_HAVE_ENUM_CLASS );
+    bit_PRESENT( bit_HAVE_BUILTIN_IS_CONSTANT_EVALUATED );
+    bit_PRESENT( bit_HAVE_IS_CONSTANT_EVALUATED );
+    bit_PRESENT( bit_HAVE_BUILTIN_BIT_CAST );
+    bit_PRESENT( bit_HAVE_UINT128 );
 //  bit_PRESENT( bit_HAVE_ENUM_CLASS_CONSTRUCTION_FROM_UNDERLYING_TYPE );
 //  bit_PRESENT( bit_HAVE_EXPLICIT_CONVERSION );
     // bit_PRESENT( bit_HAVE_INITIALIZER_LIST );
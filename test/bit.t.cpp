@@ -8,8 +8,11 @@
 
 #include "bit-main.t.hpp"
 
+#include <algorithm>    // std::copy(), std::equal(), std::lower_bound(), std::sort()
 #include <climits>      // CHAR_BIT, when bit_USES_STD_BIT
+#include <cstring>      // std::memcpy(), std::memcmp(), std::strcmp()
 #include <iostream>
+#include <iterator>     // std::distance()
 
 #ifndef  bit_COMPILE_TIME_TEST
 # define bit_COMPILE_TIME_TEST  0
@@ -17,7 +20,7 @@
 
 #define dimension_of(a)  ( sizeof(a) / sizeof(0[a]) )
 
-#if bit_CPP11_90
+#if bit_USES_STD_BIT || bit_CPP11_90
 # include <cstdint>
     using std::uint8_t;
     using std::uint16_t;
@@ -78,10 +81,16 @@ using namespace nonstd;
 // bit_cast<>()
 //
 
-// nonstd::bit_cast is not const_expr:
+// nonstd::bit_cast is const_expr only via __builtin_bit_cast():
 
 #define no_constexpr /*constexpr*/
 
+#if bit_USES_STD_BIT || ( bit_HAVE_BUILTIN_BIT_CAST && bit_CPP11_OR_GREATER )
+# define bit_HAVE_CONSTEXPR_BIT_CAST  1
+#else
+# define bit_HAVE_CONSTEXPR_BIT_CAST  0
+#endif
+
 CASE( "bit_cast<>(): successfully roundtrips uint64_t via double" " [bit.cast]" )
 {
 #if bit_CPP11_OR_GREATER
@@ -93,6 +102,36 @@ CASE( "bit_cast<>(): successfully roundtrips uint64_t via double" " [bit.cast]"
 #endif
 }
 
+#if bit_HAVE_CONSTEXPR_BIT_CAST
+namespace {
+
+// trivially copyable, but not default constructible:
+
+struct words
+{
+    uint32_t lo, hi;
+    constexpr words( uint32_t lo_, uint32_t hi_ ) : lo( lo_ ), hi( hi_ ) {}
+};
+
+}
+#endif
+
+CASE( "bit_cast<>(): allow compile-time use and a To type that is not default constructible (__builtin_bit_cast)" " [bit.cast]" )
+{
+#if bit_HAVE_CONSTEXPR_BIT_CAST
+    static_assert( bit_cast<uint64_t>( 0.78125 ) == 0x3fe9000000000000ull, "bit_cast<>() must be constexpr" );
+    static_assert( bit_cast<uint32_t>( 1.0f ) == 0x3f800000u, "bit_cast<>() must be constexpr" );
+
+    const words w = bit_cast<words>( uint64_t( 0x0123456789abcdefull ) );
+
+    EXPECT( w.lo == ( endian::native == endian::little ? 0x89abcdefu : 0x01234567u ) );
+    EXPECT( w.hi == ( endian::native == endian::little ? 0x01234567u : 0x89abcdefu ) );
+    EXPECT( bit_cast<uint64_t>( w ) == 0x0123456789abcdefull );
+#else
+    EXPECT( !!"bit_cast<>(): constexpr bit_cast is not available (no __builtin_bit_cast, or no C++11)" );
+#endif
+}
+
 CASE( "byteswap(): allow to swap bytes in 1, 2, 4, 8-byte integrals" " [bit.byteswap]" )
 {
 #if bit_HAVE_BYTESWAP
@@ -117,6 +156,87 @@ CASE( "byteswap(): allow to swap bytes in 1, 2, 4, 8-byte integrals" " [bit.byte
 #endif
 }
 
+CASE( "byteswap(): allow to swap bytes at compile time, e.g. for protocol constants (C++11)" " [bit.byteswap]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"byteswap(): not tested (bit_USES_STD_BIT)" );
+#elif bit_HAVE_CONSTEXPR_11 && ( !bit_HAVE_MSVC_BYTESWAP || bit_HAVE_IS_CONSTANT_EVALUATED )
+    constexpr uint16_t magic16 = byteswap( uint16_t(0x1234u) );
+    constexpr uint32_t magic32 = byteswap( uint32_t(0x12345678ul) );
+    constexpr uint64_t magic64 = byteswap( uint64_t(0x12345678AABBCCDDull) );
+
+    EXPECT( magic16 == uint16_t(0x3412u) );
+    EXPECT( magic32 == uint32_t(0x78563412ul) );
+    EXPECT( magic64 == uint64_t(0xDDCCBBAA78563412ull) );
+#else
+    EXPECT( !!"byteswap(): not constexpr (no C++11, or no is_constant_evaluated() with MSVC intrinsics)" );
+#endif
+}
+
+CASE( "byteswap(): allow to swap bytes in unsigned __int128 (extension)" " [bit.byteswap]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"byteswap(): unsigned __int128 not available (bit_USES_STD_BIT)" );
+#elif bit_HAVE_UINT128
+    typedef nonstd::bit::uint128_t uint128_t;
+
+    const uint128_t hi = 0x0001020304050607ull;
+    const uint128_t lo = 0x08090A0B0C0D0E0Full;
+    const uint128_t v  = ( hi << 64 ) | lo;
+    const uint128_t r  = byteswap( v );
+
+    EXPECT( uint64_t( r >> 64 ) == uint64_t(0x0F0E0D0C0B0A0908ull) );
+    EXPECT( uint64_t( r       ) == uint64_t(0x0706050403020100ull) );
+    EXPECT( !!( byteswap( r ) == v ) );
+#else
+    EXPECT( !!"byteswap(): unsigned __int128 not available" );
+#endif
+}
+
+CASE( "countl_zero(), popcount(), rotl(), bit_ceil(), ...: allow unsigned __int128 (extension)" " [bit.uint128]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"unsigned __int128 not available (bit_USES_STD_BIT)" );
+#elif bit_HAVE_UINT128
+    typedef nonstd::bit::uint128_t uint128_t;
+
+    const uint128_t one = 1;
+    const uint128_t x   = ( one << 127 ) | ( one << 64 ) | 0x5u;
+
+    EXPECT( countl_zero( uint128_t( 0 ) ) == 128 );
+    EXPECT( countl_zero( one ) == 127 );
+    EXPECT( countl_zero( one << 64 ) == 63 );
+    EXPECT( countl_zero( x ) == 0 );
+    EXPECT( countl_one( ~uint128_t( 0 ) ) == 128 );
+    EXPECT( countl_one( ~( one << 63 ) ) == 64 );
+    EXPECT( countr_zero( uint128_t( 0 ) ) == 128 );
+    EXPECT( countr_zero( one << 100 ) == 100 );
+    EXPECT( countr_one( uint128_t( ~uint64_t( 0 ) ) ) == 64 );
+    EXPECT( popcount( x ) == 4 );
+    EXPECT( popcount( ~uint128_t( 0 ) ) == 128 );
+
+    EXPECT( !!( rotl( x, 1 ) == ( ( one << 65 ) | 0xbu ) ) );
+    EXPECT( !!( rotl( x, 129 ) == rotl( x, 1 ) ) );
+    EXPECT( !!( rotr( x, -1 ) == rotl( x, 1 ) ) );
+    EXPECT( !!( rotr( x, 64 ) == ( ( one << 63 ) | ( uint128_t( 0x5u ) << 64 ) | 1u ) ) );
+    EXPECT( !!( rotl( x, 0 ) == x ) );
+
+    EXPECT( has_single_bit( one << 90 ) );
+    EXPECT_NOT( has_single_bit( x ) );
+    EXPECT( !!( bit_width( one << 90 ) == 91u ) );
+    EXPECT( !!( bit_width( uint128_t( 0 ) ) == 0u ) );
+    EXPECT( !!( bit_ceil( uint128_t( 0 ) ) == 1u ) );
+    EXPECT( !!( bit_ceil( ( one << 70 ) + 1 ) == ( one << 71 ) ) );
+    EXPECT( !!( bit_ceil( one << 70 ) == ( one << 70 ) ) );
+    EXPECT( !!( bit_floor( x ) == ( one << 127 ) ) );
+    EXPECT( !!( bit_floor( uint128_t( 0 ) ) == 0u ) );
+
+    EXPECT( ( sizeof( nonstd::bit::normalized_uint_type<uint128_t>::type ) == 16u ) );
+#else
+    EXPECT( !!"unsigned __int128 not available" );
+#endif
+}
+
 CASE( "has_single_bit(): single bit yields false for no bits set" " [bit.pow.two]" )
 {
     EXPECT_NOT( has_single_bit( 0u ) );
@@ -241,6 +361,13 @@ CASE( "countl_zero(): the number of consecutive 0 bits in the value of x, starti
     EXPECT( countl_zero( uint8_t(0x02u) ) == 6 );
     EXPECT( countl_zero( uint8_t(0x01u) ) == 7 );
 
+    EXPECT( countl_zero( uint16_t(0x0100u) ) ==  7 );
+    EXPECT( countl_zero( uint32_t(0x0100u) ) == 23 );
+#if bit_CPP11_OR_GREATER
+    EXPECT( countl_zero( uint64_t(0x0100u) ) == 55 );
+    EXPECT( countl_zero( uint64_t(0x0000000100000000ull) ) == 31 );
+#endif
+
     EXPECT( countl_zero( uint8_t(   0u) ) ==  8 );
     EXPECT( countl_zero( uint16_t(  0u) ) == 16 );
     EXPECT( countl_zero( uint32_t(  0u) ) == 32 );
@@ -262,6 +389,11 @@ CASE( "countl_one(): the number of consecutive 1 bits in the value of x, startin
     EXPECT( countl_one( uint8_t(0xfeu) ) == 7 );
     EXPECT( countl_one( uint8_t(0xffu) ) == 8 );
 
+    EXPECT( countl_one( uint16_t(0xff00u) ) ==  8 );
+#if bit_CPP11_OR_GREATER
+    EXPECT( countl_one( uint64_t(0xfffffffff0000000ull) ) == 36 );
+#endif
+
     EXPECT( countl_one( uint8_t(   -1) ) ==  8 );
     EXPECT( countl_one( uint16_t(  -1) ) == 16 );
     EXPECT( countl_one( uint32_t(  -1) ) == 32 );
@@ -282,6 +414,13 @@ CASE( "countr_zero(): the number of consecutive 0 bits in the value of x, starti
     EXPECT( countr_zero( uint8_t(0x40u) ) == 6 );
     EXPECT( countr_zero( uint8_t(0x80u) ) == 7 );
 
+    EXPECT( countr_zero( uint16_t(0x0100u) ) ==  8 );
+    EXPECT( countr_zero( uint32_t(0x80000000ul) ) == 31 );
+#if bit_CPP11_OR_GREATER
+    EXPECT( countr_zero( uint64_t(0x0000000100000000ull) ) == 32 );
+    EXPECT( countr_zero( uint64_t(0x8000000000000000ull) ) == 63 );
+#endif
+
     EXPECT( countr_zero( uint8_t(   0u) ) ==  8 );
     EXPECT( countr_zero( uint16_t(  0u) ) == 16 );
     EXPECT( countr_zero( uint32_t(  0u) ) == 32 );
@@ -303,6 +442,11 @@ CASE( "countr_one(): the number of consecutive 1 bits in the value of x, startin
     EXPECT( countr_one( uint8_t(0x7fu) ) == 7 );
     EXPECT( countr_one( uint8_t(0xffu) ) == 8 );
 
+    EXPECT( countr_one( uint16_t(0x00ffu) ) ==  8 );
+#if bit_CPP11_OR_GREATER
+    EXPECT( countr_one( uint64_t(0x0000000fffffffffull) ) == 36 );
+#endif
+
     EXPECT( countr_one( uint8_t(   -1) ) ==  8 );
     EXPECT( countr_one( uint16_t(  -1) ) == 16 );
     EXPECT( countr_one( uint32_t(  -1) ) == 32 );
@@ -324,9 +468,49 @@ CASE( "popcount(): the number of 1 bits in the value of x" " [bit.count]" )
     EXPECT( popcount( uint8_t(0xefu) ) == 7 );
     EXPECT( popcount( uint8_t(0xffu) ) == 8 );
 
+    EXPECT( popcount( uint16_t(0x8001u) ) ==  2 );
+    EXPECT( popcount( uint16_t(0xffffu) ) == 16 );
+    EXPECT( popcount( uint32_t(0x80808081ul) ) ==  5 );
+    EXPECT( popcount( uint32_t(0xfffffffful) ) == 32 );
+#if bit_CPP11_OR_GREATER
+    EXPECT( popcount( uint64_t(0x8000000000000001ull) ) ==  2 );
+    EXPECT( popcount( uint64_t(0x0123456789abcdefull) ) == 32 );
+    EXPECT( popcount( uint64_t(0xffffffffffffffffull) ) == 64 );
+#endif
+
     EXPECT( popcount( unsigned(-1) ) == static_cast<int>( CHAR_BIT * sizeof(unsigned) ) );
 }
 
+CASE( "bit operations: allow to compute in constant expressions, while using intrinsics at run time (C++14)" " [bit.constexpr]" )
+{
+#if bit_USES_STD_BIT || bit_HAVE_IS_CONSTANT_EVALUATED || ( bit_HAVE_CONSTEXPR_14 && bit_HAVE_CONSTEXPR_INTRINSICS )
+    constexpr int      lz  = countl_zero( uint32_t(0x00f00000ul) );
+    constexpr int      tz  = countr_zero( uint32_t(0x00f00000ul) );
+    constexpr int      lo  = countl_one ( uint16_t(0xff00u) );
+    constexpr int      to  = countr_one ( uint16_t(0x00ffu) );
+    constexpr int      pc  = popcount   ( uint32_t(0x80808081ul) );
+    constexpr uint8_t  rl  = rotl( uint8_t(29u), 1 );
+    constexpr uint8_t  rr  = rotr( uint8_t(29u), 1 );
+
+    EXPECT( lz ==  8 );
+    EXPECT( tz == 20 );
+    EXPECT( lo ==  8 );
+    EXPECT( to ==  8 );
+    EXPECT( pc ==  5 );
+    EXPECT( rl == uint8_t( 58u) );
+    EXPECT( rr == uint8_t(142u) );
+
+    // run-time path yields the same:
+
+    volatile uint32_t x = 0x00f00000ul;
+
+    EXPECT( countl_zero( uint32_t(x) ) == lz );
+    EXPECT( countr_zero( uint32_t(x) ) == tz );
+#else
+    EXPECT( !!"bit operations: constant evaluation not available (no C++14, or no is_constant_evaluated())" );
+#endif
+}
+
 CASE( "endian: little differs from big (corner-case when all scalars have size of 1 byte)" " [bit.endian]" )
 {
     EXPECT( nonstd::endian::little != nonstd::endian::big );
@@ -482,5 +666,1877 @@ CASE( "as_native_endian(): provide native unsigned as native endian (identity)"
 #endif
 }
 
+CASE( "byteswap_n(): swap bytes of n values in place, or from src to dst" " [bit.byteswap.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension byteswap_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension byteswap_n() not available (bit_CONFIG_STRICT)" );
+#else
+    // sizes around the SIMD block sizes, with odd tails:
+
+    uint32_t src[37];
+    uint32_t dst[37];
+
+    for ( size_t i = 0; i < dimension_of(src); ++i )
+    {
+        src[i] = static_cast<uint32_t>( 0x01020304ul * ( i + 1 ) );
+    }
+
+    size_t const sizes[] = { 0, 1, 3, 4, 5, 8, 9, 16, 17, 37 };
+
+    for ( size_t k = 0; k < dimension_of(sizes); ++k )
+    {
+        bool ok = true;
+
+        byteswap_n( src, sizes[k], dst );
+
+        for ( size_t i = 0; i < sizes[k]; ++i )
+        {
+            ok = ok && dst[i] == byteswap( src[i] );
+        }
+
+        byteswap_n( dst, sizes[k] );
+
+        for ( size_t i = 0; i < sizes[k]; ++i )
+        {
+            ok = ok && dst[i] == src[i];
+        }
+
+        EXPECT( ok );
+    }
+
+    int16_t s16[] = { 0x1234, 0x11AA, 0x0102, 0x0304, 0x0506, 0x0708, 0x090A, 0x0B0C, 0x0D0E };
+    uint8_t u8[]  = { 0x12u, 0x34u, 0x56u };
+
+    byteswap_n( s16, dimension_of(s16) );
+    byteswap_n( u8 , dimension_of(u8 ) );
+
+    EXPECT( s16[0] == int16_t(0x3412) );
+    EXPECT( s16[1] == int16_t(0xAA11) );
+    EXPECT( s16[8] == int16_t(0x0E0D) );
+    EXPECT( u8[0]  == 0x12u );
+    EXPECT( u8[2]  == 0x56u );
+#if bit_CPP11_OR_GREATER
+    uint64_t s64[] = { 0x12345678AABBCCDDull, 0x0102030405060708ull, 0x1122334455667788ull };
+
+    byteswap_n( s64, dimension_of(s64) );
+
+    EXPECT( s64[0] == 0xDDCCBBAA78563412ull );
+    EXPECT( s64[2] == 0x8877665544332211ull );
+#endif
+#endif
+}
+
+CASE( "to_big_endian_n(): convert n native, or little or big endian specified unsigned to big endian" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension to_big_endian_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension to_big_endian_n() not available (bit_CONFIG_STRICT)" );
+#else
+    uint16_t a[] = { 0x1234u, 0x5678u };
+    uint16_t b[] = { 0x1234u, 0x5678u };
+    uint16_t c[2];
+
+    to_big_endian_n( a, dimension_of(a) );
+    to_big_endian_n( b, dimension_of(b), big_endian_type() );
+    to_big_endian_n( b, dimension_of(b), c, little_endian_type() );
+
+    EXPECT( a[0] == 0x3412u );
+    EXPECT( a[1] == 0x7856u );
+    EXPECT( b[0] == 0x1234u );
+    EXPECT( b[1] == 0x5678u );
+    EXPECT( c[0] == 0x3412u );
+    EXPECT( c[1] == 0x7856u );
+
+    to_big_endian_n( b, dimension_of(b), c, big_endian_type() );
+
+    EXPECT( c[0] == 0x1234u );
+    EXPECT( c[1] == 0x5678u );
+#endif
+}
+
+CASE( "to_little_endian_n(): convert n native, or little or big endian specified unsigned to little endian" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension to_little_endian_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension to_little_endian_n() not available (bit_CONFIG_STRICT)" );
+#else
+    uint32_t a[] = { 0x12345678ul, 0xAABBCCDDul };
+    uint32_t b[] = { 0x12345678ul, 0xAABBCCDDul };
+    uint32_t c[2];
+
+    to_little_endian_n( a, dimension_of(a) );
+    to_little_endian_n( b, dimension_of(b), little_endian_type() );
+    to_little_endian_n( b, dimension_of(b), c );
+
+    EXPECT( a[0] == 0x78563412ul );
+    EXPECT( a[1] == 0xDDCCBBAAul );
+    EXPECT( b[0] == 0x12345678ul );
+    EXPECT( b[1] == 0xAABBCCDDul );
+    EXPECT( c[0] == 0x78563412ul );
+    EXPECT( c[1] == 0xDDCCBBAAul );
+#endif
+}
+
+CASE( "to_native_endian_n(): convert n native, or little or big endian specified unsigned to native endian" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension to_native_endian_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension to_native_endian_n() not available (bit_CONFIG_STRICT)" );
+#else
+    uint32_t a[] = { 0x12345678ul, 0xAABBCCDDul };
+    uint32_t c[2];
+
+    to_native_endian_n( a, dimension_of(a) );
+    to_native_endian_n( a, dimension_of(a), native_endian_type() );
+
+    EXPECT( a[0] == 0x12345678ul );
+    EXPECT( a[1] == 0xAABBCCDDul );
+
+    if ( endian::native == endian::little )
+    {
+        to_native_endian_n( a, dimension_of(a), c, big_endian_type() );
+    }
+    else
+    {
+        to_native_endian_n( a, dimension_of(a), c, little_endian_type() );
+    }
+
+    EXPECT( c[0] == 0x78563412ul );
+    EXPECT( c[1] == 0xDDCCBBAAul );
+#endif
+}
+
+CASE( "load_big(), load_little(): read big or little endian unsigned from unaligned memory" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension load_big() etc. not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension load_big() etc. not available (bit_CONFIG_STRICT)" );
+#else
+    unsigned char const frame[] = { 0x00, 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0 };
+    void const * p = frame + 1;
+
+    EXPECT( load_big   <uint16_t>( p ) == 0x1234u );
+    EXPECT( load_little<uint16_t>( p ) == 0x3412u );
+    EXPECT( load_big   <uint32_t>( p ) == 0x12345678ul );
+    EXPECT( load_little<uint32_t>( p ) == 0x78563412ul );
+    EXPECT( load_big   <uint32_t>( frame + 1 ) == 0x12345678ul );
+    EXPECT( load_little<uint32_t>( frame + 1 ) == 0x78563412ul );
+    EXPECT( load_big   < int16_t>( frame + 5 ) == int16_t(0x9abc) );
+    EXPECT( load_big   < uint8_t>( frame + 1 ) == 0x12u );
+#if bit_CPP11_OR_GREATER
+    EXPECT( load_big   <uint64_t>( p ) == 0x123456789abcdef0ull );
+    EXPECT( load_little<uint64_t>( p ) == 0xf0debc9a78563412ull );
+    EXPECT( load_big   <uint64_t>( frame + 1 ) == 0x123456789abcdef0ull );
+    EXPECT( load_little<uint64_t>( frame + 1 ) == 0xf0debc9a78563412ull );
+#endif
+#endif
+}
+
+CASE( "load_big(), load_little(): allow to read from unsigned char array at compile time (C++11)" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension load_big() etc. not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension load_big() etc. not available (bit_CONFIG_STRICT)" );
+#elif bit_HAVE_CONSTEXPR_11
+    static constexpr unsigned char header[] = { 0xca, 0xfe, 0xba, 0xbe };
+
+    constexpr uint32_t magic_big    = load_big   <uint32_t>( header );
+    constexpr uint32_t magic_little = load_little<uint32_t>( header );
+
+    EXPECT( magic_big    == 0xcafebabeul );
+    EXPECT( magic_little == 0xbebafecaul );
+#else
+    EXPECT( !!"Extension load_big() etc. not constexpr (no C++11)" );
+#endif
+}
+
+CASE( "store_big(), store_little(): write big or little endian unsigned to unaligned memory" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension store_big() etc. not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension store_big() etc. not available (bit_CONFIG_STRICT)" );
+#else
+    unsigned char frame[9] = { 0 };
+    void * p = frame + 1;
+
+    store_big( p, uint32_t(0x12345678ul) );
+
+    EXPECT( frame[1] == 0x12u );
+    EXPECT( frame[4] == 0x78u );
+
+    store_little( frame + 1, uint32_t(0x12345678ul) );
+
+    EXPECT( frame[1] == 0x78u );
+    EXPECT( frame[4] == 0x12u );
+
+    store_big( frame + 1, int16_t(0x1234) );
+
+    EXPECT( frame[1] == 0x12u );
+    EXPECT( frame[2] == 0x34u );
+#if bit_CPP11_OR_GREATER
+    store_big( p, uint64_t(0x123456789abcdef0ull) );
+
+    EXPECT( load_big<uint64_t>( p ) == 0x123456789abcdef0ull );
+    EXPECT( frame[8] == 0xf0u );
+
+    store_little( frame + 1, uint64_t(0x123456789abcdef0ull) );
+
+    EXPECT( load_little<uint64_t>( p ) == 0x123456789abcdef0ull );
+    EXPECT( frame[8] == 0x12u );
+#endif
+    EXPECT( frame[0] == 0x00u );
+#endif
+}
+
+CASE( "endian_value<>: allow to overlay a struct on big and little endian data, swapping on access" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension endian_value<> not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension endian_value<> not available (bit_CONFIG_STRICT)" );
+#else
+    struct header
+    {
+        big_uint32_t    magic;
+        big_uint16_t    version;
+        little_uint16_t flags;
+    };
+
+    unsigned char const data[] = { 0xca, 0xfe, 0xba, 0xbe, 0x00, 0x02, 0x01, 0x80 };
+
+    header h;
+    std::memcpy( &h, data, sizeof(h) );
+
+    EXPECT( sizeof(h) == 8u );
+    EXPECT( h.magic.value()   == 0xcafebabeul );
+    EXPECT( h.version.value() == 0x0002u );
+    EXPECT( h.flags.value()   == 0x8001u );
+    EXPECT( uint32_t( h.magic ) == 0xcafebabeul );
+
+    h.flags = 0x1234u;
+
+    EXPECT( h.flags.value() == 0x1234u );
+    EXPECT( std::memcmp( &h.flags, "\x34\x12", 2 ) == 0 );
+#if bit_HAVE_IS_TRIVIALLY_COPYABLE
+    EXPECT( std::is_trivially_copyable<big_uint32_t>::value );
+#endif
+#endif
+}
+
+CASE( "unaligned_endian_value<>: allow to overlay a packed struct on big and little endian data" " [bit.endian.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension unaligned_endian_value<> not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension unaligned_endian_value<> not available (bit_CONFIG_STRICT)" );
+#else
+    struct record
+    {
+        unsigned char    tag;
+        big_uint32_ut    length;
+        little_uint16_ut crc;
+    };
+
+    unsigned char const data[] = { 0x07, 0x00, 0x01, 0x02, 0x03, 0x34, 0x12 };
+
+    EXPECT( sizeof(record) == 7u );
+
+    record const * r = reinterpret_cast<record const *>( data );
+
+    EXPECT( r->tag == 0x07u );
+    EXPECT( r->length.value() == 0x00010203ul );
+    EXPECT( r->crc.value()    == 0x1234u );
+
+    record w;
+    w.length = 0x11223344ul;
+
+    EXPECT( w.length.value() == 0x11223344ul );
+#if bit_CPP11_OR_GREATER
+    little_uint64_ut const v = 0x0102030405060708ull;
+
+    EXPECT( v.value() == 0x0102030405060708ull );
+    EXPECT( sizeof(v) == 8u );
+#endif
+#endif
+}
+
+CASE( "countl_zero(), popcount(), rotl(), bit_ceil(), ...: allow std::array<uint64_t, N> as multi-word value (C++11)" " [bit.multiword.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension multi-word values not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension multi-word values not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension multi-word values not available (no C++11)" );
+#else
+    typedef std::array<uint64_t, 3> uint192;
+
+    uint192 const zero = {{ 0, 0, 0 }};
+    uint192 const ones = {{ ~0ull, ~0ull, ~0ull }};
+    uint192 const x    = {{ 0x5ull, 0, 0x8000000000000001ull }};
+
+    EXPECT( countl_zero( zero ) == 192 );
+    EXPECT( countl_zero( x ) == 0 );
+    EXPECT( countl_zero( uint192{{ 0, 0x10ull, 0 }} ) == 123 );
+    EXPECT( countl_one( ones ) == 192 );
+    EXPECT( countl_one( uint192{{ 0, ~0ull, ~0ull >> 1 }} ) == 0 );
+    EXPECT( countl_one( uint192{{ 0, ~1ull, ~0ull }} ) == 127 );
+    EXPECT( countr_zero( zero ) == 192 );
+    EXPECT( countr_zero( uint192{{ 0, 0, 0x4ull }} ) == 130 );
+    EXPECT( countr_one( uint192{{ ~0ull, 0x7ull, 0 }} ) == 67 );
+    EXPECT( popcount( x ) == 4 );
+    EXPECT( popcount( ones ) == 192 );
+
+    EXPECT( !!( rotl( x, 1 ) == uint192{{ 0xbull, 0, 0x2ull }} ) );
+    EXPECT( !!( rotl( x, 64 ) == uint192{{ 0x8000000000000001ull, 0x5ull, 0 }} ) );
+    EXPECT( !!( rotl( x, 65 + 192 ) == uint192{{ 0x2ull, 0xbull, 0 }} ) );
+    EXPECT( !!( rotr( x, -65 ) == rotl( x, 65 ) ) );
+    EXPECT( !!( rotr( x, 1 ) == uint192{{ 0x2ull, 0x8000000000000000ull, 0xc000000000000000ull }} ) );
+    EXPECT( !!( rotl( x, 0 ) == x ) );
+
+    EXPECT( has_single_bit( uint192{{ 0, 0x100ull, 0 }} ) );
+    EXPECT_NOT( has_single_bit( x ) );
+    EXPECT( bit_width( zero ) == 0 );
+    EXPECT( bit_width( uint192{{ 0, 0x100ull, 0 }} ) == 73 );
+    EXPECT( !!( bit_ceil( zero ) == uint192{{ 1, 0, 0 }} ) );
+    EXPECT( !!( bit_ceil( uint192{{ 1, 0x100ull, 0 }} ) == uint192{{ 0, 0x200ull, 0 }} ) );
+    EXPECT( !!( bit_ceil( uint192{{ 0, 0x100ull, 0 }} ) == uint192{{ 0, 0x100ull, 0 }} ) );
+    EXPECT( !!( bit_ceil( x ) == zero ) );
+    EXPECT( !!( bit_floor( x ) == uint192{{ 0, 0, 0x8000000000000000ull }} ) );
+    EXPECT( !!( bit_floor( zero ) == zero ) );
+
+    EXPECT( !!( byteswap( uint192{{ 0x0102030405060708ull, 0, 0x1112131415161718ull }} )
+        == uint192{{ 0x1817161514131211ull, 0, 0x0807060504030201ull }} ) );
+#endif
+}
+
+CASE( "popcount(data, n): the number of 1 bits in an array of unsigned values" " [bit.count.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension popcount(data, n) not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension popcount(data, n) not available (bit_CONFIG_STRICT)" );
+#else
+    // sizes around the SIMD and Harley-Seal block sizes, with odd tails:
+
+    uint8_t bytes[1031];
+
+    for ( size_t i = 0; i < dimension_of(bytes); ++i )
+    {
+        bytes[i] = static_cast<uint8_t>( i * 37u + i / 7u );
+    }
+
+    size_t const sizes[] = { 0, 1, 7, 8, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 256, 257, 1000, 1031 };
+
+    for ( size_t k = 0; k < dimension_of(sizes); ++k )
+    {
+        size_t expected = 0;
+
+        for ( size_t i = 0; i < sizes[k]; ++i )
+        {
+            expected += static_cast<size_t>( popcount( bytes[i] ) );
+        }
+
+        EXPECT( popcount( bytes, sizes[k] ) == expected );
+    }
+
+    uint16_t const words16[] = { 0x8001u, 0xffffu, 0x0000u };
+    uint32_t const words32[] = { 0x80808081ul, 0xfffffffful, 0x00000000ul };
+
+    EXPECT( popcount( words16, dimension_of(words16) ) == 18u );
+    EXPECT( popcount( words32, dimension_of(words32) ) == 37u );
+#if bit_CPP11_OR_GREATER
+    uint64_t words64[40];
+
+    for ( size_t i = 0; i < dimension_of(words64); ++i )
+    {
+        words64[i] = 0x0123456789abcdefull;
+    }
+
+    EXPECT( popcount( words64, dimension_of(words64) ) == 40u * 32u );
+    EXPECT( popcount( words64 + 1, dimension_of(words64) - 3 ) == 37u * 32u );
+#endif
+#endif
+}
+
+CASE( "and_popcount(), or_popcount(), xor_popcount(), and_not_popcount(): the number of 1 bits in a binary operation on two arrays" " [bit.count.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension and_popcount() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension and_popcount() not available (bit_CONFIG_STRICT)" );
+#else
+    // sizes around the SIMD and Harley-Seal block sizes, with odd tails:
+
+    uint8_t a[1031];
+    uint8_t b[1031];
+
+    for ( size_t i = 0; i < dimension_of(a); ++i )
+    {
+        a[i] = static_cast<uint8_t>( i * 37u + i / 7u );
+        b[i] = static_cast<uint8_t>( i * 11u + i / 3u );
+    }
+
+    size_t const sizes[] = { 0, 1, 7, 8, 31, 32, 33, 63, 64, 65, 127, 128, 129, 255, 256, 257, 1000, 1031 };
+
+    for ( size_t k = 0; k < dimension_of(sizes); ++k )
+    {
+        size_t expected_and = 0, expected_or = 0, expected_xor = 0, expected_and_not = 0;
+
+        for ( size_t i = 0; i < sizes[k]; ++i )
+        {
+            expected_and     += static_cast<size_t>( popcount( static_cast<uint8_t>( a[i] &  b[i] ) ) );
+            expected_or      += static_cast<size_t>( popcount( static_cast<uint8_t>( a[i] |  b[i] ) ) );
+            expected_xor     += static_cast<size_t>( popcount( static_cast<uint8_t>( a[i] ^  b[i] ) ) );
+            expected_and_not += static_cast<size_t>( popcount( static_cast<uint8_t>( a[i] & ~b[i] ) ) );
+        }
+
+        EXPECT( and_popcount    ( a, b, sizes[k] ) == expected_and     );
+        EXPECT( or_popcount     ( a, b, sizes[k] ) == expected_or      );
+        EXPECT( xor_popcount    ( a, b, sizes[k] ) == expected_xor     );
+        EXPECT( and_not_popcount( a, b, sizes[k] ) == expected_and_not );
+    }
+
+    EXPECT( xor_popcount( a, a, dimension_of(a) ) == 0u );
+    EXPECT( and_popcount( a, a, dimension_of(a) ) == popcount( a, dimension_of(a) ) );
+
+    uint32_t const x[] = { 0xff00ff00ul, 0x0000fffful };
+    uint32_t const y[] = { 0x0ff00ff0ul, 0xffff0000ul };
+
+    EXPECT( and_popcount    ( x, y, dimension_of(x) ) ==  8u );
+    EXPECT( or_popcount     ( x, y, dimension_of(x) ) == 56u );
+    EXPECT( xor_popcount    ( x, y, dimension_of(x) ) == 48u );
+    EXPECT( and_not_popcount( x, y, dimension_of(x) ) == 24u );
+#endif
+}
+
+CASE( "selected_kernels(): name the implementations selected at compile time or detected at run time (C++11)" " [bit.dispatch.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension selected_kernels() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension selected_kernels() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension selected_kernels() not available (no C++11)" );
+#else
+    kernel_selection const k = selected_kernels();
+
+    EXPECT( ( std::strcmp( k.popcount  , "popcnt"   ) == 0 || std::strcmp( k.popcount  , "swar"     ) == 0 ) );
+    EXPECT( ( std::strcmp( k.byteswap_n, "avx2"     ) == 0 || std::strcmp( k.byteswap_n, "ssse3"    ) == 0 || std::strcmp( k.byteswap_n, "scalar" ) == 0 ) );
+    EXPECT( ( std::strcmp( k.bitwise_n , "avx2"     ) == 0 || std::strcmp( k.bitwise_n , "scalar"   ) == 0 ) );
+    EXPECT( ( std::strcmp( k.pdep      , "bmi2"     ) == 0 || std::strcmp( k.pdep      , "software" ) == 0 ) );
+    EXPECT( ( std::strcmp( k.varint_n  , "ssse3"    ) == 0 || std::strcmp( k.varint_n  , "scalar"   ) == 0 ) );
+#if bit_HAVE_AVX2
+    EXPECT( std::strcmp( k.bitwise_n, "avx2" ) == 0 );
+#elif bit_CONFIG_NO_INTRINSICS
+    EXPECT( std::strcmp( k.popcount_n, "harley-seal" ) == 0 );
+#endif
+#if bit_USES_RUNTIME_DISPATCH
+    cpu_features const & cpu = runtime_cpu_features();
+
+    EXPECT( ( std::strcmp( k.popcount_n, "avx512-vpopcntdq" ) == 0 ) == cpu.avx512_vpopcntdq );
+    EXPECT( ( std::strcmp( k.bitwise_n , "avx2"             ) == 0 ) == cpu.avx2 );
+    EXPECT( ( std::strcmp( k.pdep      , "bmi2"             ) == 0 ) == ( cpu.bmi2 && !cpu.slow_pdep ) );
+#endif
+#endif
+}
+
+CASE( "bit_deposit(): scatter the low bits of x to the set bit positions of mask" " [bit.deposit.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_deposit() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_deposit() not available (bit_CONFIG_STRICT)" );
+#else
+    EXPECT( bit_deposit( uint8_t( 0x05 ), uint8_t( 0xf0 ) ) == uint8_t( 0x50 ) );
+    EXPECT( bit_deposit( uint8_t( 0xff ), uint8_t( 0x81 ) ) == uint8_t( 0x81 ) );
+    EXPECT( bit_deposit( uint16_t( 0x0003 ), uint16_t( 0x8100 ) ) == uint16_t( 0x8100 ) );
+    EXPECT( bit_deposit( uint32_t( 0x0000000bul ), uint32_t( 0xf0000001ul ) ) == uint32_t( 0x50000001ul ) );
+    EXPECT( bit_deposit( uint32_t( 0xfffffffful ), uint32_t( 0 ) ) == uint32_t( 0 ) );
+#if bit_CPP11_OR_GREATER
+    EXPECT( bit_deposit( uint64_t( 0x1234ull ), uint64_t( 0xffff000000000000ull ) ) == uint64_t( 0x1234000000000000ull ) );
+    EXPECT( bit_deposit( ~uint64_t( 0 ), uint64_t( 0x8000000000000001ull ) ) == uint64_t( 0x8000000000000001ull ) );
+#endif
+#endif
+}
+
+CASE( "bit_extract(): gather the bits of x at the set bit positions of mask into the low bits" " [bit.deposit.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_extract() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_extract() not available (bit_CONFIG_STRICT)" );
+#else
+    EXPECT( bit_extract( uint8_t( 0x50 ), uint8_t( 0xf0 ) ) == uint8_t( 0x05 ) );
+    EXPECT( bit_extract( uint8_t( 0x81 ), uint8_t( 0x81 ) ) == uint8_t( 0x03 ) );
+    EXPECT( bit_extract( uint16_t( 0xa5a5 ), uint16_t( 0xffff ) ) == uint16_t( 0xa5a5 ) );
+    EXPECT( bit_extract( uint32_t( 0x50000001ul ), uint32_t( 0xf0000001ul ) ) == uint32_t( 0x0000000bul ) );
+#if bit_CPP11_OR_GREATER
+    EXPECT( bit_extract( uint64_t( 0x1234000000000000ull ), uint64_t( 0xffff000000000000ull ) ) == uint64_t( 0x1234ull ) );
+
+    // extract inverts deposit on the low popcount(mask) bits:
+
+    uint64_t state = 42;
+    bool ok = true;
+
+    for ( int i = 0; i < 1000; ++i )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t const x = state;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t const mask = state & ( state >> 7 );
+
+        int const n = popcount( mask );
+        uint64_t const low = n == 64 ? x : x & ( ( uint64_t( 1 ) << n ) - 1 );
+
+        ok = ok && bit_extract( bit_deposit( x, mask ), mask ) == low;
+        ok = ok && bit_deposit( bit_extract( x, mask ), mask ) == ( x & mask );
+    }
+
+    EXPECT( ok );
+#endif
+#endif
+}
+
+CASE( "bit_deposit(), bit_extract(): allow to compute in constant expressions (C++14)" " [bit.deposit.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_deposit() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_deposit() not available (bit_CONFIG_STRICT)" );
+#elif bit_HAVE_CONSTEXPR_14 && ( bit_HAVE_IS_CONSTANT_EVALUATED || !bit_HAVE_BMI2 )
+    constexpr uint32_t dep = bit_deposit( uint32_t( 0x0000000bul ), uint32_t( 0xf0000001ul ) );
+    constexpr uint32_t ext = bit_extract( uint32_t( 0x50000001ul ), uint32_t( 0xf0000001ul ) );
+
+    EXPECT( dep == uint32_t( 0x50000001ul ) );
+    EXPECT( ext == uint32_t( 0x0000000bul ) );
+#else
+    EXPECT( !!"bit_deposit(), bit_extract(): not constexpr (no C++14, or no is_constant_evaluated() with BMI2)" );
+#endif
+}
+
+CASE( "morton_encode2(), morton_decode2(): interleave x and y into a Z-order key, and back (C++11)" " [bit.morton.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension morton_encode2() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension morton_encode2() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension morton_encode2() not available (no C++11)" );
+#else
+    EXPECT( morton_encode2( uint16_t( 0 ), uint16_t( 0 ) ) == 0u );
+    EXPECT( morton_encode2( uint16_t( 1 ), uint16_t( 0 ) ) == 1u );
+    EXPECT( morton_encode2( uint16_t( 0 ), uint16_t( 1 ) ) == 2u );
+    EXPECT( morton_encode2( uint16_t( 3 ), uint16_t( 5 ) ) == 0x27u );
+    EXPECT( morton_encode2( uint16_t( 0xffff ), uint16_t( 0 ) ) == 0x55555555u );
+    EXPECT( morton_encode2( uint32_t( 0 ), uint32_t( 0xffffffffu ) ) == 0xaaaaaaaaaaaaaaaaull );
+
+    uint16_t x16 = 0, y16 = 0;
+    uint32_t x32 = 0, y32 = 0;
+
+    morton_decode2( uint32_t( 0x27u ), x16, y16 );
+
+    EXPECT( x16 == 3u );
+    EXPECT( y16 == 5u );
+
+    morton_decode2( morton_encode2( uint32_t( 0x12345678u ), uint32_t( 0x9abcdef0u ) ), x32, y32 );
+
+    EXPECT( x32 == 0x12345678u );
+    EXPECT( y32 == 0x9abcdef0u );
+#endif
+}
+
+CASE( "morton_encode3(), morton_decode3(): interleave x, y and z into a Z-order key, and back (C++11)" " [bit.morton.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension morton_encode3() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension morton_encode3() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension morton_encode3() not available (no C++11)" );
+#else
+    EXPECT( morton_encode3( uint16_t( 1 ), uint16_t( 0 ), uint16_t( 0 ) ) == 1u );
+    EXPECT( morton_encode3( uint16_t( 0 ), uint16_t( 1 ), uint16_t( 0 ) ) == 2u );
+    EXPECT( morton_encode3( uint16_t( 0 ), uint16_t( 0 ), uint16_t( 1 ) ) == 4u );
+    EXPECT( morton_encode3( uint16_t( 3 ), uint16_t( 0 ), uint16_t( 1 ) ) == 0xdu );
+    EXPECT( morton_encode3( uint16_t( 0xffff ), uint16_t( 0 ), uint16_t( 0 ) ) == 0x0000249249249249ull );
+    EXPECT( morton_encode3( uint32_t( 0 ), uint32_t( 0 ), uint32_t( 0xffffffffu ) ) == 0x4924924924924924ull );
+
+    uint16_t x16 = 0, y16 = 0, z16 = 0;
+    uint32_t x32 = 0, y32 = 0, z32 = 0;
+
+    morton_decode3( morton_encode3( uint16_t( 0xabcd ), uint16_t( 0x1234 ), uint16_t( 0xffff ) ), x16, y16, z16 );
+
+    EXPECT( x16 == 0xabcdu );
+    EXPECT( y16 == 0x1234u );
+    EXPECT( z16 == 0xffffu );
+
+    morton_decode3( morton_encode3( uint32_t( 0x1fffff ), uint32_t( 0x012345 ), uint32_t( 0x1abcde ) ), x32, y32, z32 );
+
+    EXPECT( x32 == 0x1fffffu );
+    EXPECT( y32 == 0x012345u );
+    EXPECT( z32 == 0x1abcdeu );
+#endif
+}
+
+CASE( "morton_encode2_n(), morton_encode3_n(): encode arrays of coordinates, equal to one at a time (C++11)" " [bit.morton.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension morton_encode2_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension morton_encode2_n() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension morton_encode2_n() not available (no C++11)" );
+#else
+    // not a multiple of the vector width:
+
+    uint16_t x16[11], y16[11], z16[11];
+    uint32_t x32[11], y32[11], z32[11];
+
+    for ( size_t i = 0; i < 11; ++i )
+    {
+        x16[i] = static_cast<uint16_t>( 0xffffu - i * 4099u );
+        y16[i] = static_cast<uint16_t>( i * 5813u );
+        z16[i] = static_cast<uint16_t>( i * 31u + 7u );
+        x32[i] = 0xffffffffu - static_cast<uint32_t>( i ) * 0x01234567u;
+        y32[i] = static_cast<uint32_t>( i ) * 0x0abcdef1u;
+        z32[i] = static_cast<uint32_t>( i ) * 0x00054321u;
+    }
+
+    uint32_t keys2_16[11];
+    uint64_t keys2_32[11], keys3_16[11], keys3_32[11];
+
+    morton_encode2_n( x16, y16, 11, keys2_16 );
+    morton_encode2_n( x32, y32, 11, keys2_32 );
+    morton_encode3_n( x16, y16, z16, 11, keys3_16 );
+    morton_encode3_n( x32, y32, z32, 11, keys3_32 );
+
+    bool ok = true;
+
+    for ( size_t i = 0; i < 11; ++i )
+    {
+        ok = ok && keys2_16[i] == morton_encode2( x16[i], y16[i] );
+        ok = ok && keys2_32[i] == morton_encode2( x32[i], y32[i] );
+        ok = ok && keys3_16[i] == morton_encode3( x16[i], y16[i], z16[i] );
+        ok = ok && keys3_32[i] == morton_encode3( x32[i], y32[i], z32[i] );
+    }
+
+    EXPECT( ok );
+#endif
+}
+
+CASE( "morton_encode2(), morton_encode3(): allow to compute in constant expressions (C++14)" " [bit.morton.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension morton_encode2() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension morton_encode2() not available (bit_CONFIG_STRICT)" );
+#elif bit_HAVE_CONSTEXPR_14 && ( bit_HAVE_IS_CONSTANT_EVALUATED || !bit_HAVE_BMI2 )
+    constexpr uint32_t key2 = morton_encode2( uint16_t( 3 ), uint16_t( 5 ) );
+    constexpr uint64_t key3 = morton_encode3( uint16_t( 3 ), uint16_t( 0 ), uint16_t( 1 ) );
+
+    EXPECT( key2 == 0x27u );
+    EXPECT( key3 == 0xdu );
+#else
+    EXPECT( !!"morton_encode2(), morton_encode3(): not constexpr (no C++14, or no is_constant_evaluated() with BMI2)" );
+#endif
+}
+
+namespace {
+
+struct collect_indices
+{
+    size_t * out;
+    size_t   n;
+
+    explicit collect_indices( size_t * out_ ) : out( out_ ), n( 0 ) {}
+
+    template< class I >
+    void operator()( I i ) { out[n++] = static_cast<size_t>( i ); }
+};
+
+} // anonymous namespace
+
+CASE( "for_each_set_bit(): call f with the index of each set bit of a word" " [bit.iterate.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension for_each_set_bit() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension for_each_set_bit() not available (bit_CONFIG_STRICT)" );
+#else
+    size_t idx[64];
+
+    EXPECT( for_each_set_bit( uint8_t( 0 ), collect_indices( idx ) ).n == 0u );
+
+    collect_indices const c8 = for_each_set_bit( uint8_t( 0x91 ), collect_indices( idx ) );
+
+    EXPECT( c8.n == 3u );
+    EXPECT( idx[0] == 0u );
+    EXPECT( idx[1] == 4u );
+    EXPECT( idx[2] == 7u );
+
+    collect_indices const c32 = for_each_set_bit( uint32_t( 0xffffffffu ), collect_indices( idx ) );
+
+    EXPECT( c32.n == 32u );
+    EXPECT( idx[31] == 31u );
+#endif
+}
+
+CASE( "for_each_set_bit(): call f with the bit index of each set bit of an array of words" " [bit.iterate.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension for_each_set_bit() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension for_each_set_bit() not available (bit_CONFIG_STRICT)" );
+#else
+    // runs of zero words to skip, and a set bit after them:
+
+    uint32_t const words[] = { 0x1u, 0, 0, 0, 0, 0, 0x80000000u, 0, 0, 0, 0, 0x3u };
+    size_t idx[64];
+
+    collect_indices const c = for_each_set_bit( words, dimension_of(words), collect_indices( idx ) );
+
+    EXPECT( c.n == 4u );
+    EXPECT( idx[0] ==   0u );
+    EXPECT( idx[1] == 223u );
+    EXPECT( idx[2] == 352u );
+    EXPECT( idx[3] == 353u );
+#endif
+}
+
+CASE( "set_bit_indices(): allow to iterate over the indices of the set bits of a word or of an array of words" " [bit.iterate.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension set_bit_indices() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension set_bit_indices() not available (bit_CONFIG_STRICT)" );
+#else
+    typedef set_bit_range< set_bit_iterator<uint16_t> > word_range;
+    typedef set_bit_range< set_bit_span_iterator<uint16_t> > span_range;
+
+    word_range const r = set_bit_indices( uint16_t( 0x8102 ) );
+    word_range::iterator pos = r.begin();
+
+    EXPECT( *pos++ ==  1 );
+    EXPECT( *pos++ ==  8 );
+    EXPECT( *pos++ == 15 );
+    EXPECT( !!( pos == r.end() ) );
+    EXPECT( set_bit_indices( uint16_t( 0 ) ).empty() );
+
+    uint16_t const words[] = { 0, 0, 0, 0, 0, 0x0001u, 0, 0x8000u, 0, 0, 0, 0 };
+
+    span_range const s = set_bit_indices( words, dimension_of(words) );
+    size_t idx[4];
+    size_t n = 0;
+
+    for ( span_range::iterator it = s.begin(); it != s.end(); ++it )
+    {
+        idx[n++] = *it;
+    }
+
+    EXPECT( n == 2u );
+    EXPECT( idx[0] ==  80u );
+    EXPECT( idx[1] == 127u );
+    EXPECT( set_bit_indices( words, 5 ).empty() );
+    EXPECT( std::distance( s.begin(), s.end() ) == 2 );
+#endif
+}
+
+CASE( "bit_vector: allow to create, resize and access a dynamically sized sequence of bits (C++11)" " [bit.vector.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_vector not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_vector not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bit_vector not available (no C++11)" );
+#else
+    bit_vector a( 100 );
+    bit_vector b( 100, true );
+
+    EXPECT( a.size() == 100u );
+    EXPECT( a.num_words() == 2u );
+    EXPECT( a.none() );
+    EXPECT( b.all() );
+    EXPECT( b.count() == 100u );
+    EXPECT( b.data()[1] == 0x0000000fffffffffull );
+
+    a.set( 3 ).set( 64 ).set( 99 );
+
+    EXPECT( a[3] );
+    EXPECT( a.test( 64 ) );
+    EXPECT_NOT( a[4] );
+    EXPECT( a.count() == 3u );
+
+    a.reset( 64 ).flip( 5 );
+
+    EXPECT_NOT( a[64] );
+    EXPECT( a[5] );
+
+    a.resize( 130, true );
+
+    EXPECT( a.size() == 130u );
+    EXPECT( a.count() == 3u + 30u );
+    EXPECT( a.data()[2] == 0x3ull );
+
+    a.resize( 65 );
+
+    EXPECT( a.count() == 2u );
+    EXPECT( a.data()[1] == 0x0ull );
+
+    bit_vector c;
+
+    for ( size_t i = 0; i < 70; ++i )
+    {
+        c.push_back( i % 3 == 0 );
+    }
+
+    EXPECT( c.size() == 70u );
+    EXPECT( c.count() == 24u );
+
+    c.flip();
+
+    EXPECT( c.count() == 46u );
+    EXPECT( ( c.data()[1] >> 6 ) == 0u );
+
+    c.clear();
+
+    EXPECT( c.empty() );
+#endif
+}
+
+CASE( "bit_vector: allow bulk and, or, xor and and_not of equally sized vectors (C++11)" " [bit.vector.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_vector not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_vector not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bit_vector not available (no C++11)" );
+#else
+    // enough words for the vectorized and the scalar tail loop:
+
+    size_t const n = 7 * 64 + 5;
+
+    bit_vector a( n );
+    bit_vector b( n );
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        a.set( i, i % 2 == 0 );
+        b.set( i, i % 3 == 0 );
+    }
+
+    bit_vector const r_and = a & b;
+    bit_vector const r_or  = a | b;
+    bit_vector const r_xor = a ^ b;
+    bit_vector r_andnot = a;
+    r_andnot.and_not( b );
+
+    bool ok = true;
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        ok = ok && r_and[i]    == ( a[i] && b[i] );
+        ok = ok && r_or[i]     == ( a[i] || b[i] );
+        ok = ok && r_xor[i]    == ( a[i] != b[i] );
+        ok = ok && r_andnot[i] == ( a[i] && !b[i] );
+    }
+
+    EXPECT( ok );
+    EXPECT( r_and.count() + r_xor.count() == r_or.count() );
+    EXPECT( !!( r_and != r_or ) );
+    EXPECT( !!( ( a & a ) == a ) );
+#endif
+}
+
+CASE( "bit_vector: allow to find the first and next set bit (C++11)" " [bit.vector.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_vector not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_vector not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bit_vector not available (no C++11)" );
+#else
+    bit_vector v( 300 );
+
+    EXPECT( v.find_first() == bit_vector::npos );
+
+    v.set( 0 ).set( 63 ).set( 64 ).set( 200 ).set( 299 );
+
+    EXPECT( v.find_first()     ==   0u );
+    EXPECT( v.find_next(   0 ) ==  63u );
+    EXPECT( v.find_next(  63 ) ==  64u );
+    EXPECT( v.find_next(  64 ) == 200u );
+    EXPECT( v.find_next( 200 ) == 299u );
+    EXPECT( v.find_next( 299 ) == bit_vector::npos );
+
+    v.reset( 0 );
+
+    EXPECT( v.find_first() == 63u );
+#endif
+}
+
+CASE( "bitwise_and_n(), ...: allow to combine word arrays and count the result, over several threads (C++11)" " [bit.parallel.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bitwise_and_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bitwise_and_n() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bitwise_and_n() not available (no C++11)" );
+#else
+    // below and above the 2^16 words per thread, with a partial fused block:
+
+    size_t const sizes[] = { 0, 1, 517, 3 * 65536 + 5 };
+    unsigned const threads[] = { 1, 3, 0 };
+
+    for ( size_t k = 0; k < dimension_of(sizes); ++k )
+    {
+        size_t const n = sizes[k];
+
+        std::vector<uint64_t> a( n ), b( n );
+        uint64_t state = 12345;
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            a[i] = state;
+            b[i] = ( state >> 7 ) | ( state << 3 );
+        }
+
+        bit_vector va( 64 * n ), vb( 64 * n );
+
+        std::copy( a.begin(), a.end(), va.data() );
+        std::copy( b.begin(), b.end(), vb.data() );
+
+        for ( size_t t = 0; t < dimension_of(threads); ++t )
+        {
+            std::vector<uint64_t> r_and( a ), r_or( a ), r_xor( a ), r_andnot( a );
+
+            EXPECT( bitwise_and_n    ( r_and.data()   , b.data(), n, threads[t] ) == ( va & vb ).count() );
+            EXPECT( bitwise_or_n     ( r_or.data()    , b.data(), n, threads[t] ) == ( va | vb ).count() );
+            EXPECT( bitwise_xor_n    ( r_xor.data()   , b.data(), n, threads[t] ) == ( va ^ vb ).count() );
+            EXPECT( bitwise_and_not_n( r_andnot.data(), b.data(), n, threads[t] ) == bit_vector( va ).and_not( vb ).count() );
+
+            EXPECT( std::equal( r_and.begin(), r_and.end(), ( va & vb ).data() ) );
+            EXPECT( std::equal( r_andnot.begin(), r_andnot.end(), bit_vector( va ).and_not( vb ).data() ) );
+            EXPECT( popcount( a.data(), n, threads[t] ) == va.count() );
+        }
+    }
+#endif
+}
+
+#if !bit_USES_STD_BIT && !bit_CONFIG_STRICT && bit_CPP11_OR_GREATER
+
+namespace {
+
+// distances, radius search and top-k of n fingerprints of Bits bits, some near the query,
+// against xor_popcount() and a sort of all matches:
+
+template< size_t Bits >
+bool hamming_agrees( size_t n, size_t k )
+{
+    size_t const words = Bits / 64;
+
+    std::vector<uint64_t> query( words ), f( n * words );
+    uint64_t state = 4242 + Bits;
+
+    for ( size_t w = 0; w < words; ++w )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        query[w] = state;
+    }
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        for ( size_t w = 0; w < words; ++w )
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            f[i * words + w] = i % 5 == 0 ? query[w] ^ ( uint64_t( 1 ) << ( state >> 58 ) ) : state;
+        }
+    }
+
+    std::vector<unsigned> distances( n );
+    std::vector<hamming_match> expected( n );
+
+    hamming_distance_n<Bits>( query.data(), f.data(), n, distances.data() );
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        hamming_match const match = { i, static_cast<unsigned>( xor_popcount( query.data(), &f[i * words], words ) ) };
+        expected[i] = match;
+
+        if ( distances[i] != match.distance )
+            return false;
+    }
+
+    unsigned const radius = Bits / 4;
+    std::vector<size_t> within( n );
+    size_t const nwithin = hamming_within<Bits>( query.data(), f.data(), n, radius, within.data() );
+    size_t m = 0;
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        if ( expected[i].distance <= radius && ( m >= nwithin || within[m++] != i ) )
+            return false;
+    }
+
+    std::sort( expected.begin(), expected.end() );
+
+    std::vector<hamming_match> top( k );
+    size_t const ntop = hamming_top_k<Bits>( query.data(), f.data(), n, k, top.data() );
+
+    for ( size_t i = 0; i < ntop; ++i )
+    {
+        if ( top[i].index != expected[i].index || top[i].distance != expected[i].distance )
+            return false;
+    }
+    return m == nwithin && ntop == ( k < n ? k : n );
+}
+
+} // anonymous namespace
+
+#endif
+
+CASE( "hamming_distance_n(), hamming_within(), hamming_top_k(): allow to search fixed-width fingerprints by Hamming distance (C++11)" " [bit.hamming.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension hamming_distance_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension hamming_distance_n() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension hamming_distance_n() not available (no C++11)" );
+#else
+    // several blocks of 256 with a tail not a multiple of four, and fewer fingerprints than k:
+
+    EXPECT( hamming_agrees<  64>( 1003, 10 ) );
+    EXPECT( hamming_agrees< 192>( 1003, 10 ) );
+    EXPECT( hamming_agrees< 256>( 1003, 10 ) );
+    EXPECT( hamming_agrees< 512>( 1003, 10 ) );
+    EXPECT( hamming_agrees<1024>( 1003, 10 ) );
+    EXPECT( hamming_agrees< 256>(    7, 10 ) );
+    EXPECT( hamming_agrees< 256>(    0, 10 ) );
+    EXPECT( hamming_agrees< 256>(  300,  0 ) );
+
+    uint64_t const query[4] = { 0, 0, 0, 0 };
+    uint64_t const f[3 * 4] = { ~0ull, ~0ull, ~0ull, ~0ull, 0, 0, 0, 0x3, 0x1, 0, 0, 0 };
+
+    hamming_match top[2];
+
+    EXPECT( hamming_top_k<256>( query, f, 3, 2, top ) == 2u );
+    EXPECT( top[0].index == 2u );
+    EXPECT( top[0].distance == 1u );
+    EXPECT( top[1].index == 1u );
+    EXPECT( top[1].distance == 2u );
+#endif
+}
+
+CASE( "select_in_word(): the bit index of the k-th set bit of x, or the number of digits if there is none (C++11)" " [bit.rank.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension select_in_word() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension select_in_word() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension select_in_word() not available (no C++11)" );
+#else
+    EXPECT( select_in_word( uint8_t( 0x91 ), 0 ) == 0 );
+    EXPECT( select_in_word( uint8_t( 0x91 ), 1 ) == 4 );
+    EXPECT( select_in_word( uint8_t( 0x91 ), 2 ) == 7 );
+    EXPECT( select_in_word( uint8_t( 0x91 ), 3 ) == 8 );
+    EXPECT( select_in_word( uint32_t( 0 ), 0 ) == 32 );
+
+    uint64_t const x = 0x8421000000f00001ull;
+    int const expected[] = { 0, 20, 21, 22, 23, 48, 53, 58, 63 };
+
+    for ( int k = 0; k < static_cast<int>( dimension_of(expected) ); ++k )
+    {
+        EXPECT( select_in_word( x, k ) == expected[k] );
+    }
+
+    EXPECT( select_in_word( x, 9 ) == 64 );
+    EXPECT( select_in_word( ~uint64_t( 0 ), 63 ) == 63 );
+#endif
+}
+
+CASE( "rank_select_index: rank1(), rank0() and select1() agree with a bit-by-bit count (C++11)" " [bit.rank.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension rank_select_index not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension rank_select_index not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension rank_select_index not available (no C++11)" );
+#else
+    // sizes around the word, sub-block and block boundaries; dense, sparse and empty bitmaps:
+
+    size_t const sizes[] = { 0, 1, 63, 64, 511, 512, 2047, 2048, 2049, 5000, 40000 };
+    unsigned const densities[] = { 0, 1, 50, 100 };
+
+    uint64_t state = 12345;
+
+    for ( size_t d = 0; d < dimension_of(densities); ++d )
+    {
+        for ( size_t k = 0; k < dimension_of(sizes); ++k )
+        {
+            bit_vector v( sizes[k] );
+
+            for ( size_t i = 0; i < v.size(); ++i )
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                v.set( i, ( state >> 33 ) % 100 < densities[d] );
+            }
+
+            rank_select_index const index( v );
+
+            EXPECT( index.size()  == v.size()  );
+            EXPECT( index.count() == v.count() );
+
+            bool ok = true;
+            size_t ones = 0;
+
+            for ( size_t i = 0; i <= v.size(); ++i )
+            {
+                ok = ok && index.rank1( i ) == ones && index.rank0( i ) == i - ones;
+
+                if ( i < v.size() && v[i] )
+                {
+                    ok = ok && index.select1( ones ) == i;
+                    ++ones;
+                }
+            }
+
+            EXPECT( ok );
+            EXPECT( index.select1( ones ) == rank_select_index::npos );
+        }
+    }
+#endif
+}
+
+CASE( "rank_select_index: ignore bits beyond size() and use less than 6% of the bitmap size (C++11)" " [bit.rank.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension rank_select_index not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension rank_select_index not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension rank_select_index not available (no C++11)" );
+#else
+    uint64_t const words[] = { ~uint64_t( 0 ), ~uint64_t( 0 ) };
+
+    rank_select_index const partial( words, 100 );
+
+    EXPECT( partial.count() == 100u );
+    EXPECT( partial.rank1( 100 ) == 100u );
+    EXPECT( partial.select1( 99 ) == 99u );
+    EXPECT( partial.select1( 100 ) == rank_select_index::npos );
+
+    bit_vector const full( 1u << 20, true );
+    rank_select_index const index( full );
+
+    EXPECT( index.index_bytes() * 100 < full.num_words() * sizeof( uint64_t ) * 6 );
+    EXPECT( index.select1( ( 1u << 20 ) - 1 ) == ( 1u << 20 ) - 1 );
+#endif
+}
+
+CASE( "elias_fano: access(), next_geq() and iteration agree with the encoded sequence (C++11)" " [bit.ef.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension elias_fano not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension elias_fano not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension elias_fano not available (no C++11)" );
+#else
+    // sizes around the sample distances of 128 and 256; duplicates, dense, sparse and huge gaps:
+
+    size_t const sizes[] = { 0, 1, 2, 127, 128, 129, 255, 256, 257, 5000 };
+    uint64_t const gaps[] = { 1, 2, 100, 1000000, uint64_t( 1 ) << 48 };
+
+    uint64_t state = 12345;
+
+    for ( size_t g = 0; g < dimension_of(gaps); ++g )
+    {
+        for ( size_t k = 0; k < dimension_of(sizes); ++k )
+        {
+            std::vector<uint64_t> values( sizes[k] );
+
+            uint64_t v = 0;
+
+            for ( size_t i = 0; i < values.size(); ++i )
+            {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                values[i] = v += ( state >> 33 ) % gaps[g];
+            }
+
+            elias_fano const ef( values.data(), values.size() );
+
+            EXPECT( ef.size() == values.size() );
+
+            bool ok = true;
+            size_t i = 0;
+
+            for ( elias_fano::const_iterator pos = ef.begin(); pos != ef.end(); ++pos, ++i )
+            {
+                ok = ok && ef[i] == values[i] && *pos == values[i];
+            }
+
+            EXPECT( ok );
+            EXPECT( i == values.size() );
+
+            for ( size_t j = 0; j < values.size(); ++j )
+            {
+                uint64_t const x = values[j] - ( j % 2 );
+
+                ok = ok && ef.next_geq( x ) == size_t( std::lower_bound( values.begin(), values.end(), x ) - values.begin() );
+                ok = ok && ef.next_geq( values[j] + 1 ) == size_t( std::upper_bound( values.begin(), values.end(), values[j] ) - values.begin() );
+            }
+
+            EXPECT( ok );
+            EXPECT( ef.next_geq( 0 ) == 0u );
+        }
+    }
+#endif
+}
+
+CASE( "elias_fano: use less than 2 bits per value over the information-theoretic minimum (C++11)" " [bit.ef.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension elias_fano not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension elias_fano not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension elias_fano not available (no C++11)" );
+#else
+    // n = 2^16 values below u = 2^32: the minimum is about n * ( log2( u / n ) + log2( e ) ) = n * 17.44 bits:
+
+    size_t const n = size_t( 1 ) << 16;
+
+    std::vector<uint64_t> values( n );
+
+    uint64_t state = 12345;
+
+    for ( size_t i = 0; i < n; ++i )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values[i] = state >> 32;
+    }
+
+    std::sort( values.begin(), values.end() );
+
+    elias_fano const ef( values.data(), n );
+
+    EXPECT( ef.low_bits() == 15 );
+    EXPECT( ef.size_in_bits() * 100 < n * 1944 );
+    EXPECT( ef.access( n - 1 ) == values.back() );
+    EXPECT( ef.next_geq( values.back() + 1 ) == n );
+
+    uint64_t const seven[] = { 7 };
+    elias_fano const single( seven, 1 ), empty;
+
+    EXPECT( single[0] == 7u );
+    EXPECT( single.next_geq( 8 ) == 1u );
+    EXPECT( empty.next_geq( 0 ) == 0u );
+    EXPECT( !!( empty.begin() == empty.end() ) );
+#endif
+}
+
+#if !bit_USES_STD_BIT && !bit_CONFIG_STRICT && bit_CPP11_OR_GREATER
+
+namespace {
+
+// a roaring bitmap and a bit_vector with the same values below 2^20:
+
+struct roaring_reference
+{
+    roaring_reference() : bits( size_t( 1 ) << 20 ) {}
+
+    void add( uint32_t x ) { rb.add( x ); bits.set( x ); }
+
+    roaring_bitmap rb;
+    bit_vector bits;
+};
+
+// array, bitmap and run containers, and keys only in one of a and b:
+
+void fill_roaring( roaring_reference & a, roaring_reference & b )
+{
+    uint64_t state = 12345;
+
+    for ( uint32_t x = 0; x < 0x10000u; x += 3 ) a.add( x );
+    for ( uint32_t x = 0x10000u; x < 0x20000u; x += 2 ) b.add( x );
+    for ( uint32_t x = 0x20000u + 100; x < 0x20000u + 30000; ++x ) a.add( x );
+    for ( uint32_t x = 0x20000u; x < 0x30000u; x += 7 ) b.add( x );
+    for ( uint32_t x = 0x50000u; x < 0x50000u + 10; ++x ) a.add( x );
+    for ( uint32_t x = 0x60000u; x < 0x60000u + 10; ++x ) b.add( x );
+
+    for ( int i = 0; i < 3000; ++i )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        a.add( static_cast<uint32_t>( state >> 33 ) % 0x30000u );
+        b.add( static_cast<uint32_t>( state >> 13 ) % 0x30000u );
+    }
+}
+
+bool equal_values( roaring_bitmap const & rb, bit_vector const & bits )
+{
+    size_t n = 0;
+
+    for ( roaring_bitmap::const_iterator pos = rb.begin(); pos != rb.end(); ++pos, ++n )
+    {
+        if ( !bits[ *pos ] )
+            return false;
+    }
+    return n == bits.count() && rb.cardinality() == n;
+}
+
+} // anonymous namespace
+
+#endif
+
+CASE( "roaring_bitmap: allow to add, remove, find and iterate values in array, bitmap and run containers (C++11)" " [bit.roaring.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension roaring_bitmap not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension roaring_bitmap not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension roaring_bitmap not available (no C++11)" );
+#else
+    roaring_reference a, b;
+
+    fill_roaring( a, b );
+
+    EXPECT( equal_values( a.rb, a.bits ) );
+    EXPECT( a.rb.num_containers() == 4u );
+    EXPECT( a.rb.contains( 0x20000u + 100 ) );
+    EXPECT( !a.rb.contains( 0x70000u ) );
+
+    size_t const bytes = a.rb.size_in_bytes();
+
+    EXPECT( a.rb.run_optimize() );
+    EXPECT( a.rb.size_in_bytes() < bytes );
+    EXPECT( equal_values( a.rb, a.bits ) );
+
+    // into and out of runs, and from bitmap back to array:
+
+    a.rb.add( 0x20000u + 99 ).remove( 0x20000u + 200 );
+    a.bits.set( 0x20000u + 99 ).reset( 0x20000u + 200 );
+
+    for ( uint32_t x = 0; x < 0x10000u; x += 6 )
+    {
+        a.rb.remove( x );
+        a.bits.reset( x );
+    }
+
+    EXPECT( equal_values( a.rb, a.bits ) );
+
+    for ( uint32_t x = 0x50000u; x < 0x50000u + 10; ++x )
+    {
+        a.rb.remove( x );
+    }
+
+    EXPECT( a.rb.num_containers() == 3u );
+    EXPECT( !a.rb.contains( 0x50000u ) );
+
+    uint32_t const values[] = { 7, 0xffffffffu, 3, 7 };
+    roaring_bitmap const c( values, dimension_of(values) );
+
+    EXPECT( c.cardinality() == 3u );
+    EXPECT( *c.begin() == 3u );
+    EXPECT( c.contains( 0xffffffffu ) );
+    EXPECT( !!( roaring_bitmap().begin() == roaring_bitmap().end() ) );
+#endif
+}
+
+CASE( "roaring_bitmap: allow and, or, xor and and_not between all kinds of containers (C++11)" " [bit.roaring.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension roaring_bitmap not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension roaring_bitmap not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension roaring_bitmap not available (no C++11)" );
+#else
+    roaring_reference a, b;
+
+    fill_roaring( a, b );
+
+    for ( int optimize = 0; optimize < 2; ++optimize )
+    {
+        if ( optimize )
+        {
+            a.rb.run_optimize();
+            b.rb.run_optimize();
+        }
+
+        roaring_bitmap r_andnot = a.rb;
+        r_andnot.and_not( b.rb );
+
+        EXPECT( equal_values( a.rb & b.rb, a.bits & b.bits ) );
+        EXPECT( equal_values( a.rb | b.rb, a.bits | b.bits ) );
+        EXPECT( equal_values( a.rb ^ b.rb, a.bits ^ b.bits ) );
+        EXPECT( equal_values( r_andnot   , bit_vector( a.bits ).and_not( b.bits ) ) );
+        EXPECT( equal_values( b.rb & a.rb, a.bits & b.bits ) );
+        EXPECT( !!( ( a.rb | b.rb ) == ( b.rb | a.rb ) ) );
+    }
+
+    EXPECT( !!( ( a.rb & a.rb ) == a.rb ) );
+    EXPECT( ( a.rb ^ a.rb ).empty() );
+#endif
+}
+
+CASE( "roaring_bitmap: allow to serialize and deserialize in the portable Roaring format (C++11)" " [bit.roaring.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension roaring_bitmap not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension roaring_bitmap not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension roaring_bitmap not available (no C++11)" );
+#else
+    // arrays only: cookie 12346, count, key and cardinality - 1, offsets, values:
+
+    uint32_t const values[] = { 1, 2, 3, 0x10000u };
+    roaring_bitmap const arrays( values, dimension_of(values) );
+
+    unsigned char const arrays_bytes[] = {
+        0x3a, 0x30, 0, 0,  2, 0, 0, 0,  0, 0, 2, 0,  1, 0, 0, 0,  24, 0, 0, 0,  30, 0, 0, 0,  1, 0, 2, 0, 3, 0,  0, 0 };
+
+    std::vector<unsigned char> out( arrays.serialized_size() );
+
+    EXPECT( out.size() == sizeof( arrays_bytes ) );
+    EXPECT( arrays.serialize( out.data() ) == sizeof( arrays_bytes ) );
+    EXPECT( std::equal( out.begin(), out.end(), arrays_bytes ) );
+
+    // runs: cookie 12347 with count - 1, run flags, key and cardinality - 1, no offsets below 4 containers, runs:
+
+    roaring_bitmap runs;
+
+    for ( uint32_t x = 0; x < 100; ++x )
+    {
+        runs.add( x );
+    }
+    runs.run_optimize();
+
+    unsigned char const runs_bytes[] = { 0x3b, 0x30, 0, 0,  1,  0, 0, 99, 0,  1, 0,  0, 0, 99, 0 };
+
+    out.resize( runs.serialized_size() );
+
+    EXPECT( runs.serialize( out.data() ) == sizeof( runs_bytes ) );
+    EXPECT( std::equal( out.begin(), out.end(), runs_bytes ) );
+
+    // round trip with all kinds of containers; reject truncated data:
+
+    roaring_reference a, b;
+
+    fill_roaring( a, b );
+    a.rb.run_optimize();
+
+    out.resize( a.rb.serialized_size() );
+    a.rb.serialize( out.data() );
+
+    roaring_bitmap r;
+
+    EXPECT( r.deserialize( out.data(), out.size() ) == out.size() );
+    EXPECT( !!( r == a.rb ) );
+    EXPECT( r.deserialize( out.data(), out.size() - 1 ) == 0u );
+    EXPECT( r.empty() );
+    EXPECT( r.deserialize( arrays_bytes, sizeof( arrays_bytes ) ) == sizeof( arrays_bytes ) );
+    EXPECT( !!( r == arrays ) );
+#endif
+}
+
+CASE( "big_bit_reader, little_bit_reader: allow to peek, skip and read fields of up to 56 bits (C++11)" " [bit.stream.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_reader not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_reader not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bit_reader not available (no C++11)" );
+#else
+    unsigned char const data[] = { 0xa5, 0x0f, 0x81, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+
+    big_bit_reader big( data, sizeof( data ) );
+
+    EXPECT( big.peek( 4 ) == 0xau );
+    EXPECT( big.read( 4 ) == 0xau );
+    EXPECT( big.read( 8 ) == 0x50u );
+    EXPECT( big.read_bit() == true );
+    EXPECT( big.position() == 13u );
+    big.align();
+    EXPECT( big.position() == 16u );
+    EXPECT( big.read( 56 ) == 0x8123456789abcdull );
+    EXPECT( big.bits_left() == 8u );
+    EXPECT( big.read( 8 ) == 0xefu );
+    EXPECT( !big.overrun() );
+
+    little_bit_reader little( data, sizeof( data ) );
+
+    EXPECT( little.read( 4 ) == 0x5u );
+    EXPECT( little.read( 8 ) == 0xfau );
+    EXPECT( little.read( 0 ) == 0u );
+    little.skip( 4 );
+    EXPECT( little.read( 32 ) == 0x67452381u );
+    EXPECT( little.read( 32 ) == 0xefcdab89u );
+    EXPECT( little.bits_left() == 0u );
+
+    // unsigned Exp-Golomb codes 0, 1, 2, 3 and 7: 1 010 011 00100 0001000
+
+    unsigned char const ue[] = { 0xa6, 0x41, 0x00 };
+    big_bit_reader golomb( ue, sizeof( ue ) );
+
+    unsigned values[5] = {};
+    for ( unsigned & v : values )
+    {
+        int const zeros = countl_zero( golomb.peek( 32 ) ) - 32;
+        golomb.skip( zeros );
+        v = static_cast<unsigned>( golomb.read( zeros + 1 ) - 1 );
+    }
+
+    EXPECT( values[0] == 0u );
+    EXPECT( values[1] == 1u );
+    EXPECT( values[2] == 2u );
+    EXPECT( values[3] == 3u );
+    EXPECT( values[4] == 7u );
+#endif
+}
+
+CASE( "big_bit_writer, little_bit_writer: allow to write fields that read back equal (C++11)" " [bit.stream.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_writer not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_writer not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bit_writer not available (no C++11)" );
+#else
+    unsigned char data[2] = {};
+    big_bit_writer small( data, sizeof( data ) );
+
+    small.write( 0xa, 4 );
+    small.write_bit( true );
+    EXPECT( small.finish() == 1u );
+    EXPECT( data[0] == 0xa8u );
+
+    // fields of 0..56 bits across the word-wise and byte-wise parts of the range:
+
+    unsigned char big_data[200]    = {};
+    unsigned char little_data[200] = {};
+
+    big_bit_writer    big_out   ( big_data   , sizeof( big_data    ) );
+    little_bit_writer little_out( little_data, sizeof( little_data ) );
+
+    uint64_t state = 12345;
+    size_t   bits  = 0;
+
+    for ( int n = 0; bits + 56 <= 8 * sizeof( big_data ); n = ( n + 1 ) % 57 )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        big_out.write( state, n );
+        little_out.write( state, n );
+        bits += size_t( n );
+    }
+
+    EXPECT( big_out.position() == bits );
+    EXPECT( big_out.finish() == ( bits + 7 ) / 8 );
+    EXPECT( little_out.finish() == ( bits + 7 ) / 8 );
+    EXPECT( !big_out.overflow() );
+
+    big_bit_reader    big_in   ( big_data   , sizeof( big_data    ) );
+    little_bit_reader little_in( little_data, sizeof( little_data ) );
+
+    bool ok = true;
+    state = 12345;
+    bits  = 0;
+
+    for ( int n = 0; bits + 56 <= 8 * sizeof( big_data ); n = ( n + 1 ) % 57 )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t const expected = n ? state & ( ~uint64_t( 0 ) >> ( 64 - n ) ) : 0;
+        ok = ok && big_in.read( n ) == expected && little_in.read( n ) == expected;
+        bits += size_t( n );
+    }
+
+    EXPECT( ok );
+#endif
+}
+
+CASE( "big_bit_reader, big_bit_writer: read zero bits beyond the end and discard bits written beyond the end (C++11)" " [bit.stream.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bit_reader not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bit_reader not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bit_reader not available (no C++11)" );
+#else
+    unsigned char data[3] = { 0xff, 0xff, 0xff };
+
+    big_bit_reader in( data, sizeof( data ) );
+
+    EXPECT( in.read( 20 ) == 0xfffffu );
+    EXPECT( !in.overrun() );
+    EXPECT( in.read( 8 ) == 0xf0u );
+    EXPECT( in.overrun() );
+    EXPECT( in.bits_left() == 0u );
+
+    big_bit_writer out( data, 2 );
+
+    out.write( 0x123, 12 );
+    EXPECT( !out.overflow() );
+    out.write( 0x456, 12 );
+    EXPECT( out.overflow() );
+    EXPECT( out.finish() == 2u );
+    EXPECT( data[0] == 0x12u );
+    EXPECT( data[1] == 0x34u );
+    EXPECT( data[2] == 0xffu );
+#endif
+}
+
+CASE( "varint_encode(), varint_decode(): write and read LEB128 with 7 bits per byte, low group first" " [bit.varint.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension varint_encode() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension varint_encode() not available (bit_CONFIG_STRICT)" );
+#else
+    unsigned char buf[10] = { 0 };
+    uint32_t v = 0;
+
+    EXPECT( varint_size( 0u ) == 1u );
+    EXPECT( varint_size( 127u ) == 1u );
+    EXPECT( varint_size( 128u ) == 2u );
+    EXPECT( varint_size( 0xffffffffu ) == 5u );
+    EXPECT( varint_max_size<uint32_t>::value == 5u );
+
+    EXPECT( varint_encode( 300u, buf ) == 2u );
+    EXPECT( buf[0] == 0xacu );
+    EXPECT( buf[1] == 0x02u );
+    EXPECT( varint_decode( buf, sizeof( buf ), v ) == 2u );
+    EXPECT( v == 300u );
+
+    EXPECT( varint_encode( 0xffffffffu, buf ) == 5u );
+    EXPECT( buf[4] == 0x0fu );
+    EXPECT( varint_decode( buf, sizeof( buf ), v ) == 5u );
+    EXPECT( v == 0xffffffffu );
+
+#if bit_CPP11_OR_GREATER
+    uint64_t w = 0;
+
+    EXPECT( varint_max_size<uint64_t>::value == 10u );
+    EXPECT( varint_encode( uint64_t( 1 ) << 63, buf ) == 10u );
+    EXPECT( buf[9] == 0x01u );
+    EXPECT( varint_decode( buf, sizeof( buf ), w ) == 10u );
+    EXPECT( w == uint64_t( 1 ) << 63 );
+#endif
+#endif
+}
+
+CASE( "varint_decode(): return 0 for an encoding that does not end within the input or the maximum size" " [bit.varint.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension varint_decode() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension varint_decode() not available (bit_CONFIG_STRICT)" );
+#else
+    unsigned char const truncated[] = { 0xac };
+    unsigned char const overlong[]  = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+    uint32_t v = 42;
+
+    EXPECT( varint_decode( truncated, sizeof( truncated ), v ) == 0u );
+    EXPECT( varint_decode( overlong , sizeof( overlong  ), v ) == 0u );
+    EXPECT( v == 42u );
+#endif
+}
+
+CASE( "varint_decode_n(): decode n values equal to one at a time, or return 0 if the input ends early" " [bit.varint.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension varint_decode_n() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension varint_decode_n() not available (bit_CONFIG_STRICT)" );
+#else
+    // lengths of 1 to 5 bytes in varying runs:
+
+    uint32_t values[300] = { 0 };
+    uint32_t state = 12345;
+
+    for ( size_t i = 0; i < dimension_of( values ); ++i )
+    {
+        state = state * 1103515245u + 12345u;
+        values[i] = state >> ( ( 4 - i / 7 % 5 ) * 7 );
+    }
+
+    unsigned char buf[ 5 * dimension_of( values ) ] = { 0 };
+    size_t size = 0;
+
+    for ( size_t i = 0; i < dimension_of( values ); ++i )
+    {
+        size += varint_encode( values[i], buf + size );
+    }
+
+    uint32_t decoded[ dimension_of( values ) ] = { 0 };
+
+    EXPECT( varint_decode_n( buf, size, decoded, dimension_of( values ) ) == size );
+    EXPECT( std::memcmp( decoded, values, sizeof( values ) ) == 0 );
+    EXPECT( varint_decode_n( buf, size - 1, decoded, dimension_of( values ) ) == 0u );
+
+#if bit_CPP11_OR_GREATER
+    uint64_t wide[ dimension_of( values ) ] = { 0 };
+
+    EXPECT( varint_decode_n( buf, size, wide, dimension_of( values ) ) == size );
+    EXPECT( std::equal( values, values + dimension_of( values ), wide ) );
+#endif
+#endif
+}
+
+CASE( "bitpack(), bitunpack(): pack 32-bit values at each width 0..32 and back, in the 4-lane block layout" " [bit.pack.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bitpack() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bitpack() not available (bit_CONFIG_STRICT)" );
+#else
+    // two blocks and a tail:
+
+    uint32_t values  [300] = { 0 };
+    uint32_t packed  [300] = { 0 };
+    uint32_t unpacked[300] = { 0 };
+    uint32_t state = 12345;
+
+    for ( size_t i = 0; i < dimension_of( values ); ++i )
+    {
+        state = state * 1103515245u + 12345u;
+        values[i] = state ^ ( state << 13 );
+    }
+
+    bool ok = true;
+
+    for ( int bits = 0; bits <= 32; ++bits )
+    {
+        size_t const n = dimension_of( values );
+        uint32_t const mask = bits == 32 ? ~0u : ( 1u << bits ) - 1u;
+
+        size_t const written = bitpack( values, n, bits, packed );
+        size_t const read    = bitunpack( packed, n, bits, unpacked );
+
+        ok = ok && written == bitpack_size( n, bits ) && read == written;
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            ok = ok && unpacked[i] == ( values[i] & mask );
+        }
+    }
+    EXPECT( ok );
+
+    // value 4k+j of a block in lane j:
+
+    uint32_t ones[128] = { 1, 1, 0, 0, 1 };
+
+    EXPECT( bitpack( ones, 128, 1, packed ) == 4u );
+    EXPECT( packed[0] == 3u );
+    EXPECT( packed[1] == 1u );
+    EXPECT( packed[2] == 0u );
+#endif
+}
+
+CASE( "bitpack(), bitunpack(): pack 64-bit values at each width 0..64 and back (C++11)" " [bit.pack.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bitpack() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bitpack() not available (bit_CONFIG_STRICT)" );
+#elif !bit_CPP11_OR_GREATER
+    EXPECT( !!"Extension bitpack() not available (no C++11)" );
+#else
+    uint64_t values  [100] = { 0 };
+    uint64_t packed  [100] = { 0 };
+    uint64_t unpacked[100] = { 0 };
+    uint64_t state = 12345;
+
+    for ( size_t i = 0; i < dimension_of( values ); ++i )
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        values[i] = state;
+    }
+
+    bool ok = true;
+
+    for ( int bits = 0; bits <= 64; ++bits )
+    {
+        size_t const n = dimension_of( values );
+        uint64_t const mask = bits == 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << bits ) - 1u;
+
+        size_t const written = bitpack( values, n, bits, packed );
+
+        ok = ok && written == bitpack_size64( n, bits ) && bitunpack( packed, n, bits, unpacked ) == written;
+
+        for ( size_t i = 0; i < n; ++i )
+        {
+            ok = ok && unpacked[i] == ( values[i] & mask );
+        }
+    }
+    EXPECT( ok );
+#endif
+}
+
+CASE( "bitpack_for(), bitpack_delta(): pack relative to the block minimum, or as differences, and back" " [bit.pack.extension]" )
+{
+#if bit_USES_STD_BIT
+    EXPECT( !!"Extension bitpack_for() not available (bit_USES_STD_BIT)" );
+#elif bit_CONFIG_STRICT
+    EXPECT( !!"Extension bitpack_for() not available (bit_CONFIG_STRICT)" );
+#else
+    // sorted identifiers with gaps below 16, from a large base:
+
+    uint32_t ids     [1000] = { 0 };
+    uint32_t unpacked[1000] = { 0 };
+    uint32_t packed  [1000 + 2 * 8] = { 0 };
+    uint32_t state = 12345;
+
+    ids[0] = 3000000000u;
+    for ( size_t i = 1; i < dimension_of( ids ); ++i )
+    {
+        state = state * 1103515245u + 12345u;
+        ids[i] = ids[i - 1] + ( state >> 28 );
+    }
+
+    size_t const n = dimension_of( ids );
+
+    EXPECT( bitpack_bound( n ) <= dimension_of( packed ) );
+
+    size_t const for_words = bitpack_for( ids, n, packed );
+
+    EXPECT( for_words < n / 2 );
+    EXPECT( bitunpack_for( packed, n, unpacked ) == for_words );
+    EXPECT( std::equal( ids, ids + n, unpacked ) );
+
+    size_t const delta_words = bitpack_delta( ids, n, packed );
+
+    EXPECT( delta_words < for_words );
+    EXPECT( bitunpack_delta( packed, n, unpacked ) == delta_words );
+    EXPECT( std::equal( ids, ids + n, unpacked ) );
+
+    // a block width above 32, as in a corrupt stream, is rejected:
+
+    packed[1] = 33;
+
+    EXPECT( bitunpack_for  ( packed, n, unpacked ) == 0u );
+    EXPECT( bitunpack_delta( packed, n, unpacked ) == 0u );
+#endif
+}
+
 // g++ -std=c++11 -I../include -o bit.t.exe bit.t.cpp && bit.t.exe
 // cl -EHsc -I../include bit.t.cpp && bit.t.exe